@@ -0,0 +1,67 @@
+
+
+#ifndef S_BENCHMARK_H
+#define S_BENCHMARK_H
+
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Machine-readable result of a single benchmark
+ */
+struct BenchmarkResult {
+    // identifier of the benchmark
+    std::string name;
+    // parameters the benchmark was run with
+    nlohmann::json parameters;
+    // measured values
+    nlohmann::json metrics;
+};
+
+/**
+ * @brief Run a benchmark body a number of times and measure the wall-clock time per operation
+ *
+ * @param name Identifier of the benchmark
+ * @param parameters Parameters the benchmark was run with
+ * @param operations Number of operations performed by a single call of the body
+ * @param repetitions Number of times the body is executed, the fastest one is reported
+ * @param body Function to measure
+ * @return BenchmarkResult
+ */
+inline BenchmarkResult timeBenchmark(const std::string &name, const nlohmann::json &parameters,
+                                     const size_t operations, const size_t repetitions,
+                                     const std::function<void(size_t)> &body) {
+    double best = std::numeric_limits<double>::max();
+    for (size_t r = 0; r < repetitions; r++) {
+        auto start = std::chrono::steady_clock::now();
+        body(r);
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    BenchmarkResult result{name, parameters, nlohmann::json::object()};
+    result.metrics["wall_s"] = best;
+    result.metrics["operations"] = operations;
+    result.metrics["ns_per_op"] = operations > 0 ? best * 1e9 / static_cast<double>(operations) : 0.;
+    return result;
+}
+
+void runMicroBenchmarks(std::vector<BenchmarkResult> &results, size_t scale, size_t repetitions);
+
+void runSchedulerBenchmark(std::vector<BenchmarkResult> &results, int *argc, char **argv,
+                           size_t num_hosts, size_t num_jobs, size_t num_passes, const std::string &workdir);
+
+void runMacroBenchmarks(std::vector<BenchmarkResult> &results, const std::string &dcsim_path, const std::string &workdir,
+                        const std::vector<size_t> &num_jobs, const std::vector<size_t> &num_files, const std::vector<size_t> &num_hosts);
+
+void runStreamingModeComparison(std::vector<BenchmarkResult> &results, const std::string &dcsim_path, const std::string &workdir,
+                                size_t num_jobs, size_t num_files, size_t num_hosts, const std::vector<size_t> &block_sizes);
+
+std::string writeBenchmarkPlatform(const std::string &workdir, size_t num_hosts);
+
+#endif//S_BENCHMARK_H
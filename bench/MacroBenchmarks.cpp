@@ -0,0 +1,309 @@
+#include "Benchmark.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/**
+ * @brief Write a platform with a star of worker hosts, each providing a local cache,
+ * around a router connecting them to a GRID storage and the host running the execution controllers
+ *
+ * @param workdir Directory to write the platform file to
+ * @param num_hosts Number of worker hosts
+ * @return path of the platform file
+ *
+ * @throw std::runtime_error
+ */
+std::string writeBenchmarkPlatform(const std::string &workdir, const size_t num_hosts) {
+    std::string path = workdir + "/bench_platform_" + std::to_string(num_hosts) + ".xml";
+    std::ofstream platform(path, std::ios::out | std::ios::trunc);
+    if (!platform.is_open()) {
+        throw std::runtime_error("Couldn't open platform file " + path + " for writing!");
+    }
+    platform << "<?xml version=\"1.0\"?>\n"
+             << "<!DOCTYPE platform SYSTEM \"https://simgrid.org/simgrid.dtd\">\n"
+             << "<platform version=\"4.1\">\n"
+             << "    <config>\n"
+             << "        <prop id=\"network/loopback-bw\" value=\"1000000000000\"/>\n"
+             << "    </config>\n"
+             << "    <zone id=\"bench\" routing=\"Floyd\">\n";
+    for (size_t h = 0; h < num_hosts; h++) {
+        platform << "        <host id=\"worker" << h << "\" speed=\"1Gf\" core=\"16\">\n"
+                 << "            <prop id=\"type\" value=\"worker,cache\"/>\n"
+                 << "            <prop id=\"ram\" value=\"64GiB\"/>\n"
+                 << "            <disk id=\"cache\" read_bw=\"10Gbps\" write_bw=\"10Gbps\">\n"
+                 << "                <prop id=\"size\" value=\"2TB\"/>\n"
+                 << "                <prop id=\"mount\" value=\"/\"/>\n"
+                 << "            </disk>\n"
+                 << "        </host>\n";
+    }
+    platform << "        <host id=\"storage\" speed=\"10Gf\" core=\"16\">\n"
+             << "            <prop id=\"type\" value=\"storage\"/>\n"
+             << "            <prop id=\"ram\" value=\"64GiB\"/>\n"
+             << "            <disk id=\"grid\" read_bw=\"100Gbps\" write_bw=\"100Gbps\">\n"
+             << "                <prop id=\"size\" value=\"10000TB\"/>\n"
+             << "                <prop id=\"mount\" value=\"/\"/>\n"
+             << "            </disk>\n"
+             << "        </host>\n"
+             << "        <host id=\"wms\" speed=\"10Gf\" core=\"16\">\n"
+             << "            <prop id=\"type\" value=\"scheduler,executor\"/>\n"
+             << "            <prop id=\"ram\" value=\"16GiB\"/>\n"
+             << "        </host>\n"
+             << "        <router id=\"gateway\"/>\n";
+    for (size_t h = 0; h < num_hosts; h++) {
+        platform << "        <link id=\"worker_link" << h << "\" bandwidth=\"10Gbps\" latency=\"100us\"/>\n";
+    }
+    platform << "        <link id=\"storage_link\" bandwidth=\"100Gbps\" latency=\"10ms\"/>\n"
+             << "        <link id=\"wms_link\" bandwidth=\"10Gbps\" latency=\"100us\"/>\n";
+    for (size_t h = 0; h < num_hosts; h++) {
+        platform << "        <route src=\"gateway\" dst=\"worker" << h << "\"><link_ctn id=\"worker_link" << h << "\"/></route>\n";
+    }
+    platform << "        <route src=\"gateway\" dst=\"storage\"><link_ctn id=\"storage_link\"/></route>\n"
+             << "        <route src=\"gateway\" dst=\"wms\"><link_ctn id=\"wms_link\"/></route>\n"
+             << "    </zone>\n"
+             << "</platform>\n";
+    platform.close();
+    return path;
+}
+
+/**
+ * @brief Write workload and dataset configurations of a streaming workload reading a single dataset
+ *
+ * @param workdir Directory to write the configurations to
+ * @param num_jobs Number of jobs
+ * @param num_files Number of files in the dataset
+ * @return paths of the workload and the dataset configuration
+ */
+std::pair<std::string, std::string> writeBenchmarkConfigurations(const std::string &workdir, const size_t num_jobs, const size_t num_files) {
+    std::string tag = std::to_string(num_jobs) + "_" + std::to_string(num_files);
+
+    nlohmann::json dataset;
+    dataset["bench_dataset"] = {
+            {"location", {"storage"}},
+            {"num_files", num_files},
+            {"filesize", {{"type", "gaussian"}, {"average", 1.e9}, {"sigma", 1.e8}}}};
+    nlohmann::json workload;
+    workload["bench_workload"] = {
+            {"num_jobs", num_jobs},
+            {"cores", {{"type", "histogram"}, {"counts", {0, 1}}, {"bins", {0.5, 1.5, 2.5}}}},
+            {"flops", {{"type", "gaussian"}, {"average", 1.e12}, {"sigma", 1.e11}}},
+            {"memory", {{"type", "gaussian"}, {"average", 2.e9}, {"sigma", 0}}},
+            {"outfilesize", {{"type", "gaussian"}, {"average", 1.e8}, {"sigma", 0}}},
+            {"workload_type", "streaming"},
+            {"submission_time", 0},
+            {"infile_datasets", {"bench_dataset"}}};
+
+    std::string dataset_path = workdir + "/bench_dataset_" + tag + ".json";
+    std::string workload_path = workdir + "/bench_workload_" + tag + ".json";
+    std::ofstream(dataset_path, std::ios::out | std::ios::trunc) << dataset.dump(4);
+    std::ofstream(workload_path, std::ios::out | std::ios::trunc) << workload.dump(4);
+    return std::make_pair(workload_path, dataset_path);
+}
+
+/**
+ * @brief Run dc-sim as a separate process and collect its exit status,
+ * wall-clock time, peak RSS and self-profiling information
+ *
+ * @param result Result the metrics are added to
+ * @param args Command line of the process, starting with the path to the dc-sim executable
+ * @param profile_path Path of the self-profiling report the process writes
+ *
+ * @throw std::runtime_error
+ */
+void runDCSimProcess(BenchmarkResult &result, std::vector<std::string> args, const std::string &profile_path) {
+    args.emplace_back("--profile-output");
+    args.push_back(profile_path);
+    std::vector<char *> c_args;
+    for (auto &arg: args) c_args.push_back(arg.data());
+    c_args.push_back(nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error("Couldn't fork a process for the macro benchmark!");
+    }
+    if (pid == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDOUT_FILENO);
+        dup2(devnull, STDERR_FILENO);
+        execv(c_args[0], c_args.data());
+        _exit(127);
+    }
+    int status = 0;
+    struct rusage usage {};
+    wait4(pid, &status, 0, &usage);
+    auto end = std::chrono::steady_clock::now();
+
+    result.metrics["exit_status"] = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    result.metrics["wall_s"] = std::chrono::duration<double>(end - start).count();
+    result.metrics["max_rss_kb"] = usage.ru_maxrss;
+    std::ifstream profile(profile_path);
+    if (profile.is_open()) {
+        result.metrics["profile"] = nlohmann::json::parse(profile, nullptr, false);
+        profile.close();
+        std::remove(profile_path.c_str());
+    }
+}
+
+/**
+ * @brief Run a single scenario as a separate dc-sim process and collect
+ * its wall-clock time, peak RSS and self-profiling information
+ */
+BenchmarkResult runMacroScenario(const std::string &dcsim_path, const std::string &workdir,
+                                 const size_t num_jobs, const size_t num_files, const size_t num_hosts) {
+    std::string platform_path = writeBenchmarkPlatform(workdir, num_hosts);
+    auto configurations = writeBenchmarkConfigurations(workdir, num_jobs, num_files);
+
+    BenchmarkResult result{"macro_streaming", {{"jobs", num_jobs}, {"files", num_files}, {"hosts", num_hosts}}, nlohmann::json::object()};
+    runDCSimProcess(result,
+                    {dcsim_path,
+                     "--platform", platform_path,
+                     "--output-file", "/dev/null",
+                     "--workload-configurations", configurations.first,
+                     "--dataset-configurations", configurations.second},
+                    workdir + "/bench_profile.json");
+    return result;
+}
+
+/**
+ * @brief Read the start and end dates of the jobs from the output-dump of a simulation
+ *
+ * @param path Path of the output-dump file
+ * @return start and end date by job tag
+ *
+ * @throw std::runtime_error
+ */
+std::map<std::string, std::pair<double, double>> readJobDates(const std::string &path) {
+    std::ifstream filedump(path);
+    if (!filedump.is_open()) {
+        throw std::runtime_error("Couldn't open output-file " + path + " of the streaming mode comparison!");
+    }
+    std::map<std::string, std::pair<double, double>> dates;
+    std::string line;
+    std::getline(filedump, line);// header
+    while (std::getline(filedump, line)) {
+        // job.tag, machine.name, hitrate, job.start, job.end, ...
+        std::vector<std::string> fields;
+        std::stringstream row(line);
+        std::string field;
+        while (std::getline(row, field, ',')) fields.push_back(field);
+        if (fields.size() < 5) continue;
+        dates[fields[0]] = std::make_pair(std::stod(fields[3]), std::stod(fields[4]));
+    }
+    return dates;
+}
+
+/**
+ * @brief Run the same scenario with the block and the fluid streaming engine for several block sizes
+ * and report the deviation of the fluid engine from the block engine, i.e. the relative difference
+ * of the makespans and the mean and maximum relative difference of the job runtimes,
+ * as well as the reduction of streamed compute activities
+ *
+ * @param results Collection the results are appended to
+ * @param dcsim_path Path to the dc-sim executable
+ * @param workdir Directory to write generated platforms, configurations and output-dumps to
+ * @param num_jobs Number of jobs
+ * @param num_files Number of files
+ * @param num_hosts Number of worker hosts
+ * @param block_sizes XRootD block sizes to compare the engines at
+ *
+ * @throw std::runtime_error
+ */
+void runStreamingModeComparison(std::vector<BenchmarkResult> &results, const std::string &dcsim_path, const std::string &workdir,
+                                const size_t num_jobs, const size_t num_files, const size_t num_hosts,
+                                const std::vector<size_t> &block_sizes) {
+    std::string platform_path = writeBenchmarkPlatform(workdir, num_hosts);
+    auto configurations = writeBenchmarkConfigurations(workdir, num_jobs, num_files);
+    for (auto const &block_size: block_sizes) {
+        std::cerr << "Comparing the streaming engines with " << block_size << " bytes blocks..." << std::endl;
+        BenchmarkResult result{"streaming_mode_comparison",
+                               {{"jobs", num_jobs}, {"files", num_files}, {"hosts", num_hosts}, {"block_size", block_size}},
+                               nlohmann::json::object()};
+        std::map<std::string, std::map<std::string, std::pair<double, double>>> dates;
+        for (std::string mode: {"block", "fluid"}) {
+            std::string output_path = workdir + "/bench_streaming_" + mode + ".csv";
+            BenchmarkResult run{mode, nlohmann::json::object(), nlohmann::json::object()};
+            runDCSimProcess(run,
+                            {dcsim_path,
+                             "--platform", platform_path,
+                             "--output-file", output_path,
+                             "--workload-configurations", configurations.first,
+                             "--dataset-configurations", configurations.second,
+                             "--xrd-blocksize", std::to_string(block_size),
+                             "--xrd-streaming-mode", mode},
+                            workdir + "/bench_profile.json");
+            if (run.metrics["exit_status"] != 0) {
+                throw std::runtime_error("The " + mode + " streaming run of the comparison failed!");
+            }
+            dates[mode] = readJobDates(output_path);
+            std::remove(output_path.c_str());
+            result.metrics[mode] = run.metrics;
+        }
+
+        double makespan[2] = {0., 0.};
+        double sum_deviation = 0.;
+        double max_deviation = 0.;
+        size_t num_compared = 0;
+        for (auto const &[tag, block_dates]: dates["block"]) {
+            makespan[0] = std::max(makespan[0], block_dates.second);
+            auto fluid_dates = dates["fluid"].find(tag);
+            if (fluid_dates == dates["fluid"].end()) continue;
+            double block_runtime = block_dates.second - block_dates.first;
+            double fluid_runtime = fluid_dates->second.second - fluid_dates->second.first;
+            if (block_runtime <= 0.) continue;
+            double deviation = std::abs(fluid_runtime - block_runtime) / block_runtime;
+            sum_deviation += deviation;
+            max_deviation = std::max(max_deviation, deviation);
+            num_compared++;
+        }
+        for (auto const &entry: dates["fluid"]) {
+            makespan[1] = std::max(makespan[1], entry.second.second);
+        }
+        if (num_compared != dates["block"].size() || num_compared != dates["fluid"].size()) {
+            throw std::runtime_error("The streaming engines completed different jobs!");
+        }
+        result.metrics["makespan_block_s"] = makespan[0];
+        result.metrics["makespan_fluid_s"] = makespan[1];
+        result.metrics["makespan_deviation"] = makespan[0] > 0. ? std::abs(makespan[1] - makespan[0]) / makespan[0] : 0.;
+        result.metrics["job_runtime_deviation_mean"] = num_compared > 0 ? sum_deviation / static_cast<double>(num_compared) : 0.;
+        result.metrics["job_runtime_deviation_max"] = max_deviation;
+        auto streamed_blocks = [&result](const std::string &mode) {
+            auto const &profile = result.metrics[mode]["profile"];
+            return profile.is_object() ? profile.value("counters", nlohmann::json::object()).value("StreamedBlocks", 0.) : 0.;
+        };
+        if (streamed_blocks("fluid") > 0.) {
+            result.metrics["streamed_activity_reduction"] = streamed_blocks("block") / streamed_blocks("fluid");
+        }
+        results.push_back(result);
+    }
+}
+
+/**
+ * @brief Run the full grid of macro scenarios
+ *
+ * @param results Collection the results are appended to
+ * @param dcsim_path Path to the dc-sim executable
+ * @param workdir Directory to write generated platforms and configurations to
+ * @param num_jobs Numbers of jobs to scan
+ * @param num_files Numbers of files to scan
+ * @param num_hosts Numbers of worker hosts to scan
+ */
+void runMacroBenchmarks(std::vector<BenchmarkResult> &results, const std::string &dcsim_path, const std::string &workdir,
+                        const std::vector<size_t> &num_jobs, const std::vector<size_t> &num_files, const std::vector<size_t> &num_hosts) {
+    for (auto const &jobs: num_jobs) {
+        for (auto const &files: num_files) {
+            for (auto const &hosts: num_hosts) {
+                std::cerr << "Running macro scenario with " << jobs << " jobs, " << files << " files and " << hosts << " hosts..." << std::endl;
+                results.push_back(runMacroScenario(dcsim_path, workdir, jobs, files, hosts));
+            }
+        }
+    }
+}
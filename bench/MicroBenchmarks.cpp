@@ -0,0 +1,146 @@
+#include <wrench-dev.h>
+
+#include "Benchmark.h"
+
+#include "LRU_FileList.h"
+#include "Dataset.h"
+#include "Workload.h"
+#include "sampling/Sampler.h"
+
+#include <random>
+
+
+/**
+ * @brief JSON description of a histogram distribution with a few bins,
+ * shaped like the ones derived from real job records
+ */
+nlohmann::json benchmarkHistogram(double low, double high) {
+    nlohmann::json json;
+    json["type"] = "histogram";
+    std::vector<double> bins;
+    for (int b = 0; b <= 20; b++) {
+        bins.push_back(low + (high - low) * b / 20.);
+    }
+    json["bins"] = bins;
+    json["counts"] = std::vector<int>{1, 4, 9, 16, 25, 36, 49, 64, 81, 100, 100, 81, 64, 49, 36, 25, 16, 9, 4, 1};
+    return json;
+}
+
+/**
+ * @brief JSON description of a gaussian distribution
+ */
+nlohmann::json benchmarkGaussian(double average, double sigma) {
+    nlohmann::json json;
+    json["type"] = "gaussian";
+    json["average"] = average;
+    json["sigma"] = sigma;
+    return json;
+}
+
+/**
+ * @brief Benchmarks of the LRU_FileList operations used on every cache lookup, with its default LRU policy
+ *
+ * @param results Collection the results are appended to
+ * @param num_files Number of files in the list
+ * @param repetitions Number of repetitions of each benchmark
+ */
+void benchmarkLRUFileList(std::vector<BenchmarkResult> &results, const size_t num_files, const size_t repetitions) {
+    std::vector<std::shared_ptr<wrench::DataFile>> files;
+    files.reserve(num_files);
+    for (size_t f = 0; f < num_files; f++) {
+        files.push_back(wrench::Simulation::addFile("bench_lru_" + std::to_string(f), 1000000));
+    }
+    std::mt19937 gen(42);
+    std::vector<size_t> touch_order(num_files);
+    std::uniform_int_distribution<size_t> pick(0, num_files - 1);
+    for (auto &t: touch_order) t = pick(gen);
+
+    nlohmann::json parameters = {{"files", num_files}};
+    LRU_FileList lru_list;
+    results.push_back(timeBenchmark("lru_touch_new", parameters, num_files, 1, [&](size_t) {
+        for (auto const &f: files) lru_list.touchFile(f.get());
+    }));
+    results.push_back(timeBenchmark("lru_touch_existing", parameters, num_files, repetitions, [&](size_t) {
+        for (auto const &t: touch_order) lru_list.touchFile(files[t].get());
+    }));
+    results.push_back(timeBenchmark("lru_lookup", parameters, num_files, repetitions, [&](size_t) {
+        size_t found = 0;
+        for (auto const &t: touch_order) found += lru_list.hasFile(files[t]);
+        if (found == 0) throw std::runtime_error("LRU benchmark lost all files!");
+    }));
+    results.push_back(timeBenchmark("lru_evict", parameters, num_files, 1, [&](size_t) {
+        for (size_t f = 0; f < num_files; f++) lru_list.removeLRUFile();
+    }));
+}
+
+/**
+ * @brief Benchmarks of single draws from the samplers behind dataset and workload generation
+ *
+ * @param results Collection the results are appended to
+ * @param num_draws Number of draws per repetition
+ * @param repetitions Number of repetitions of each benchmark
+ */
+void benchmarkSamplers(std::vector<BenchmarkResult> &results, const size_t num_draws, const size_t repetitions) {
+    std::mt19937 gen(42);
+    nlohmann::json parameters = {{"draws", num_draws}};
+    std::vector<std::pair<std::string, Sampler>> samplers = {
+            {"sample_histogram", Sampler(benchmarkHistogram(1.e8, 4.e9), false, 0.)},
+            {"sample_gaussian", Sampler(benchmarkGaussian(1.e8, 1.e8), false, 0.)},
+            {"sample_poisson", Sampler(nlohmann::json{{"type", "poisson"}, {"mu", 2}}, true, 1.)}};
+    for (auto const &[name, sampler]: samplers) {
+        results.push_back(timeBenchmark(name, parameters, num_draws, repetitions, [&, &sampler = sampler](size_t) {
+            double sum = 0.;
+            for (size_t d = 0; d < num_draws; d++) sum += sampler(gen);
+            if (sum < 0.) throw std::runtime_error("Sampler benchmark drew negative values!");
+        }));
+    }
+}
+
+/**
+ * @brief Benchmarks of dataset construction, workload sampling and the assignment of files to jobs
+ *
+ * @param results Collection the results are appended to
+ * @param num_jobs Number of jobs in the workload
+ * @param num_files Number of files in the dataset
+ * @param repetitions Number of repetitions of each benchmark
+ */
+void benchmarkWorkloadGeneration(std::vector<BenchmarkResult> &results, const size_t num_jobs, const size_t num_files, const size_t repetitions) {
+    nlohmann::json parameters = {{"jobs", num_jobs}, {"files", num_files}};
+
+    std::vector<Dataset> datasets;
+    results.push_back(timeBenchmark("dataset_construction", parameters, num_files, repetitions, [&](size_t r) {
+        datasets.clear();
+        datasets.emplace_back(std::vector<std::string>{"storage"}, num_files,
+                              benchmarkHistogram(1.e8, 4.e9), "bench_ds" + std::to_string(r), 42);
+    }));
+
+    std::vector<Workload> workloads;
+    results.push_back(timeBenchmark("workload_sampling", parameters, num_jobs, repetitions, [&](size_t r) {
+        workloads.clear();
+        nlohmann::json cores = {{"type", "histogram"}, {"counts", {0, 10, 1, 0, 0, 0, 0, 2}}, {"bins", {0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5}}};
+        workloads.emplace_back(num_jobs, cores,
+                               benchmarkHistogram(1.e11, 1.e13), benchmarkGaussian(2.e9, 2.e8),
+                               benchmarkGaussian(1.e8, 1.e7), WorkloadType::Streaming,
+                               "bench_wl" + std::to_string(r), 0., 42,
+                               std::vector<std::string>{datasets.back().name});
+    }));
+
+    std::vector<Workload> unassigned_workloads(repetitions, workloads.back());
+    results.push_back(timeBenchmark("assign_files", parameters, num_files, repetitions, [&](size_t r) {
+        unassigned_workloads[r].assignFiles(datasets);
+    }));
+}
+
+/**
+ * @brief Run all benchmarks which don't need a running simulation
+ *
+ * @param results Collection the results are appended to
+ * @param scale Number of files, the number of jobs is a tenth of it
+ * @param repetitions Number of repetitions of each benchmark
+ */
+void runMicroBenchmarks(std::vector<BenchmarkResult> &results, const size_t scale, const size_t repetitions) {
+    std::cerr << "Running micro benchmarks with scale " << scale << "..." << std::endl;
+    benchmarkLRUFileList(results, scale, repetitions);
+    benchmarkSamplers(results, scale, repetitions);
+    benchmarkWorkloadGeneration(results, std::max<size_t>(scale / 10, 1), scale, repetitions);
+}
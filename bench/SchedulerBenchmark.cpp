@@ -0,0 +1,116 @@
+#include <wrench-dev.h>
+
+#include "Benchmark.h"
+
+#include "JobScheduler.h"
+#include "WorkloadExecutionController.h"
+#include "Workload.h"
+
+#include <memory>
+#include <random>
+
+
+/**
+ * @brief Execution controller timing the scheduling passes of the JobScheduler
+ * once all compute services are up and running
+ */
+class SchedulerBenchmarkController : public wrench::ExecutionController {
+public:
+    SchedulerBenchmarkController(const std::vector<std::shared_ptr<wrench::ComputeService>> &compute_services,
+                                 const std::shared_ptr<wrench::StorageService> &grid_storage_service,
+                                 const std::string &hostname, const size_t num_jobs, const size_t num_passes,
+                                 std::vector<BenchmarkResult> &results) : wrench::ExecutionController(hostname, "scheduler-bench"),
+                                                                          compute_services(compute_services),
+                                                                          grid_storage_service(grid_storage_service),
+                                                                          num_jobs(num_jobs),
+                                                                          num_passes(num_passes),
+                                                                          results(results) {}
+
+private:
+    std::vector<std::shared_ptr<wrench::ComputeService>> compute_services;
+    std::shared_ptr<wrench::StorageService> grid_storage_service;
+    size_t num_jobs;
+    size_t num_passes;
+    std::vector<BenchmarkResult> &results;
+
+    int main() override {
+        const size_t num_workloads = 10;
+        auto job_scheduler = std::make_shared<JobScheduler>(this->compute_services);
+
+        // Queue jobs asking for more cores than any host has, so that every pass scans each queued job
+        // against all compute services without submitting one. The execution controllers only hold
+        // the queues the scheduler walks and are never launched.
+        std::vector<std::unique_ptr<WorkloadExecutionController>> execution_controllers;
+        for (size_t w = 0; w < num_workloads; w++) {
+            size_t workload_jobs = this->num_jobs / num_workloads + (w < this->num_jobs % num_workloads ? 1 : 0);
+            std::vector<JobSpecification> jobs(workload_jobs);
+            for (auto &job: jobs) {
+                job.cores = 17;
+                job.total_flops = 1e9;
+                job.total_mem = 1e9;
+            }
+            std::vector<sg_size_t> outfile_sizes(workload_jobs, 1e6);
+            Workload workload(jobs, outfile_sizes.data(), WorkloadType::Calculation, "bench" + std::to_string(w), 0.);
+            execution_controllers.push_back(std::make_unique<WorkloadExecutionController>(
+                    workload, job_scheduler, std::set<std::shared_ptr<wrench::StorageService>>{this->grid_storage_service},
+                    std::set<std::shared_ptr<wrench::StorageService>>{}, this->getHostname(), "", false, std::mt19937()));
+            job_scheduler->addExecutionController(execution_controllers.back().get());
+        }
+
+        nlohmann::json parameters = {{"hosts", this->compute_services.size()}, {"jobs", this->num_jobs},
+                                     {"workloads", num_workloads}, {"passes", this->num_passes}};
+        // Operations are the queued jobs scanned, each against all compute services
+        this->results.push_back(timeBenchmark("schedule_blocked_queue", parameters, this->num_passes * this->num_jobs, 3, [&](size_t) {
+            for (size_t p = 0; p < this->num_passes; p++) {
+                job_scheduler->schedule();
+            }
+        }));
+
+        size_t num_queued = 0;
+        for (auto const &ec: execution_controllers) {
+            num_queued += ec->getNumJobsQueued();
+        }
+        if (num_queued != this->num_jobs) throw std::runtime_error("Scheduler benchmark submitted an impossible job!");
+        return 0;
+    }
+};
+
+/**
+ * @brief Run the JobScheduler benchmarks inside a simulation on a generated platform.
+ * As SimGrid supports a single simulation per process, this has to be the last benchmark run in-process.
+ *
+ * @param results Collection the results are appended to
+ * @param argc
+ * @param argv
+ * @param num_hosts Number of worker hosts of the generated platform
+ * @param num_jobs Number of jobs queued for the scheduler
+ * @param num_passes Number of scheduling passes to time
+ * @param workdir Directory to write the generated platform to
+ */
+void runSchedulerBenchmark(std::vector<BenchmarkResult> &results, int *argc, char **argv,
+                           const size_t num_hosts, const size_t num_jobs, const size_t num_passes, const std::string &workdir) {
+    std::cerr << "Running scheduler benchmarks with " << num_hosts << " hosts..." << std::endl;
+    auto simulation = wrench::Simulation::createSimulation();
+    simulation->init(argc, argv);
+    simulation->instantiatePlatform(writeBenchmarkPlatform(workdir, num_hosts));
+
+    std::vector<std::shared_ptr<wrench::ComputeService>> compute_services;
+    for (size_t h = 0; h < num_hosts; h++) {
+        std::string host = "worker" + std::to_string(h);
+        compute_services.push_back(
+                simulation->add(
+                        new wrench::BareMetalComputeService(
+                                host,
+                                {std::make_pair(
+                                        host,
+                                        std::make_tuple(
+                                                wrench::Simulation::getHostNumCores(host),
+                                                wrench::Simulation::getHostMemoryCapacity(host)))},
+                                "")));
+    }
+    // The execution controllers of the workloads need a GRID storage to write their output-files to
+    auto grid_storage_service = simulation->add(
+            wrench::SimpleStorageService::createSimpleStorageService("storage", {"/"}, {}, {}));
+    simulation->add(new SchedulerBenchmarkController(compute_services, grid_storage_service, "wms", num_jobs, num_passes, results));
+    simulation->launch();
+}
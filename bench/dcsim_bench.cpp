@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+
+#include <boost/program_options.hpp>
+
+#include <fstream>
+#include <iostream>
+
+#include <unistd.h>
+
+namespace po = boost::program_options;
+
+
+/**
+ * @brief Path of the dc-sim executable built next to this benchmark executable
+ */
+std::string defaultDCSimPath() {
+    char buffer[4096];
+    ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+    if (length <= 0) return "dc-sim";
+    std::string self(buffer, length);
+    return self.substr(0, self.find_last_of('/') + 1) + "dc-sim";
+}
+
+/**
+ * @brief Benchmark suite of the simulator: micro benchmarks of the hot data structures and of the
+ * workload generation, the scheduling passes of the scheduler, end-to-end macro scenarios
+ * run as separate dc-sim processes and the comparison of the streaming engines. Results are written as a JSON array.
+ */
+int main(int argc, char **argv) {
+    po::options_description desc("Allowed options");
+    auto op = desc.add_options();
+    op("help,h", "show brief usage message\n");
+    op("micro-only", po::bool_switch()->default_value(false), "only run the micro benchmarks")("macro-only", po::bool_switch()->default_value(false), "only run the macro benchmarks");
+    op("output,o", po::value<std::string>()->value_name("<out file>")->default_value(""), "path for the JSON file containing the results (default: stdout)");
+    op("dc-sim", po::value<std::string>()->default_value(defaultDCSimPath()), "path to the dc-sim executable used for the macro benchmarks");
+    op("jobs", po::value<std::vector<size_t>>()->multitoken()->default_value(std::vector<size_t>{100, 1000}, "100 1000"), "numbers of jobs of the macro scenarios");
+    op("files", po::value<std::vector<size_t>>()->multitoken()->default_value(std::vector<size_t>{1000, 10000}, "1000 10000"), "numbers of files of the macro scenarios");
+    op("hosts", po::value<std::vector<size_t>>()->multitoken()->default_value(std::vector<size_t>{10, 100}, "10 100"), "numbers of worker hosts of the macro scenarios");
+    op("block-sizes", po::value<std::vector<size_t>>()->multitoken()->default_value(std::vector<size_t>{10000000, 100000000}, "10000000 100000000"), "XRootD block sizes the block and fluid streaming engines are compared at, on the first scenario of the grid");
+    op("scale", po::value<size_t>()->default_value(100000), "number of files used in the micro benchmarks");
+    op("repetitions", po::value<size_t>()->default_value(5), "number of repetitions of each micro benchmark, the fastest one is reported");
+    op("workdir", po::value<std::string>()->default_value("/tmp"), "directory for generated platforms and configurations");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help")) {
+            std::cerr << desc << std::endl;
+            return 0;
+        }
+        po::notify(vm);
+    } catch (std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl
+                  << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    bool run_micro = !vm["macro-only"].as<bool>();
+    bool run_macro = !vm["micro-only"].as<bool>();
+    std::string workdir = vm["workdir"].as<std::string>();
+
+    std::vector<BenchmarkResult> results;
+    try {
+        if (run_macro) {
+            runMacroBenchmarks(results, vm["dc-sim"].as<std::string>(), workdir,
+                               vm["jobs"].as<std::vector<size_t>>(),
+                               vm["files"].as<std::vector<size_t>>(),
+                               vm["hosts"].as<std::vector<size_t>>());
+            runStreamingModeComparison(results, vm["dc-sim"].as<std::string>(), workdir,
+                                       vm["jobs"].as<std::vector<size_t>>().front(),
+                                       vm["files"].as<std::vector<size_t>>().front(),
+                                       vm["hosts"].as<std::vector<size_t>>().front(),
+                                       vm["block-sizes"].as<std::vector<size_t>>());
+        }
+        if (run_micro) {
+            runMicroBenchmarks(results, vm["scale"].as<size_t>(), vm["repetitions"].as<size_t>());
+            // a single simulation can be run per process, hence the scheduler benchmark comes last
+            int sim_argc = 1;
+            runSchedulerBenchmark(results, &sim_argc, argv, 1000, 1000, 100, workdir);
+        }
+    } catch (std::runtime_error &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    nlohmann::json output = nlohmann::json::array();
+    for (auto const &result: results) {
+        output.push_back({{"name", result.name}, {"parameters", result.parameters}, {"metrics", result.metrics}});
+    }
+    if (vm["output"].as<std::string>().empty()) {
+        std::cout << output.dump(4) << std::endl;
+    } else {
+        std::ofstream filedump(vm["output"].as<std::string>(), std::ios::out | std::ios::trunc);
+        if (!filedump.is_open()) {
+            std::cerr << "Couldn't open output-file " << vm["output"].as<std::string>() << " for benchmark results!" << std::endl;
+            return 1;
+        }
+        filedump << output.dump(4) << std::endl;
+        filedump.close();
+    }
+    return 0;
+}
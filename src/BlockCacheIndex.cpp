@@ -0,0 +1,141 @@
+#include <wrench-dev.h>
+
+#include "BlockCacheIndex.h"
+#include "SimpleSimulator.h"
+
+
+std::map<wrench::StorageService *, BlockCacheIndex> BlockCacheIndex::indices;
+
+
+/**
+ * @brief Block index of a cache
+ *
+ * @param cache Cache storage service
+ * @return the index
+ */
+BlockCacheIndex &BlockCacheIndex::get(const std::shared_ptr<wrench::StorageService> &cache) {
+    return BlockCacheIndex::indices[cache.get()];
+}
+
+/**
+ * @brief Number of blocks of SimpleSimulator::xrd_block_size a file consists of
+ *
+ * @param file
+ * @return size_t
+ */
+size_t BlockCacheIndex::getNumBlocks(const std::shared_ptr<wrench::DataFile> &file) {
+    return static_cast<size_t>((file->getSize() + SimpleSimulator::xrd_block_size - 1) / SimpleSimulator::xrd_block_size);
+}
+
+/**
+ * @brief Size of a block of a file, which is smaller than the block size for the last one
+ *
+ * @param file
+ * @param block Block number
+ * @return sg_size_t
+ */
+sg_size_t BlockCacheIndex::getBlockSize(const std::shared_ptr<wrench::DataFile> &file, const size_t block) {
+    sg_size_t block_start = static_cast<sg_size_t>(block) * SimpleSimulator::xrd_block_size;
+    return std::min<sg_size_t>(SimpleSimulator::xrd_block_size, file->getSize() - block_start);
+}
+
+/**
+ * @brief Space occupied in a cache according to the cache granularity,
+ * taken from the simulator's own bookkeeping
+ *
+ * @param cache Cache storage service
+ * @return sg_size_t
+ */
+sg_size_t BlockCacheIndex::getOccupiedSpace(const std::shared_ptr<wrench::StorageService> &cache) {
+    if (SimpleSimulator::cache_granularity == CacheGranularity::BlockGranularity) {
+        return BlockCacheIndex::get(cache).getUsedSpace();
+    }
+    return SimpleSimulator::global_file_map[cache].getTotalSize();
+}
+
+/**
+ * @brief Checks whether a block of a file is cached
+ *
+ * @param file
+ * @param block Block number
+ * @return true if the block is cached, false otherwise
+ */
+bool BlockCacheIndex::hasBlock(const std::shared_ptr<wrench::DataFile> &file, const size_t block) const {
+    auto entry = this->entries.find(file.get());
+    if (entry == this->entries.end()) return false;
+    return (entry->second.bitmap[block / 64] >> (block % 64)) & 1ULL;
+}
+
+/**
+ * @brief Mark a block of a file as cached and the file as most recently used
+ *
+ * @param file
+ * @param block Block number
+ */
+void BlockCacheIndex::addBlock(const std::shared_ptr<wrench::DataFile> &file, const size_t block) {
+    auto &entry = this->getEntry(file);
+    uint64_t bit = 1ULL << (block % 64);
+    if (!(entry.bitmap[block / 64] & bit)) {
+        entry.bitmap[block / 64] |= bit;
+        sg_size_t block_size = BlockCacheIndex::getBlockSize(file, block);
+        entry.cached_bytes += block_size;
+        this->used_space += block_size;
+    }
+}
+
+/**
+ * @brief Mark all blocks of a file as cached
+ *
+ * @param file
+ */
+void BlockCacheIndex::addFile(const std::shared_ptr<wrench::DataFile> &file) {
+    for (size_t block = 0; block < BlockCacheIndex::getNumBlocks(file); block++) {
+        this->addBlock(file, block);
+    }
+}
+
+/**
+ * @brief Mark a file with cached blocks as most recently used
+ *
+ * @param file
+ */
+void BlockCacheIndex::touchFile(const std::shared_ptr<wrench::DataFile> &file) {
+    auto entry = this->entries.find(file.get());
+    if (entry == this->entries.end()) return;
+    this->lru_list.splice(this->lru_list.begin(), this->lru_list, entry->second.lru_position);
+}
+
+/**
+ * @brief Drop all cached blocks of the least recently used file
+ *
+ * @return the number of bytes freed, 0 if the cache is empty
+ */
+sg_size_t BlockCacheIndex::removeLRUFile() {
+    if (this->lru_list.empty()) return 0;
+    auto file = this->lru_list.back();
+    this->lru_list.pop_back();
+    auto entry = this->entries.find(file);
+    sg_size_t freed = entry->second.cached_bytes;
+    this->used_space -= freed;
+    this->entries.erase(entry);
+    return freed;
+}
+
+/**
+ * @brief Entry of a file, created and marked as most recently used
+ *
+ * @param file
+ * @return Entry&
+ */
+BlockCacheIndex::Entry &BlockCacheIndex::getEntry(const std::shared_ptr<wrench::DataFile> &file) {
+    auto entry = this->entries.find(file.get());
+    if (entry != this->entries.end()) {
+        this->lru_list.splice(this->lru_list.begin(), this->lru_list, entry->second.lru_position);
+        return entry->second;
+    }
+    Entry &new_entry = this->entries[file.get()];
+    new_entry.bitmap.assign((BlockCacheIndex::getNumBlocks(file) + 63) / 64, 0);
+    this->lru_list.push_front(file.get());
+    new_entry.lru_position = this->lru_list.begin();
+    return new_entry;
+}
@@ -0,0 +1,57 @@
+
+
+#ifndef S_BLOCKCACHEINDEX_H
+#define S_BLOCKCACHEINDEX_H
+
+#include <list>
+#include <unordered_map>
+
+#include <wrench-dev.h>
+
+/**
+ * @brief Index of the blocks of files held by a cache, keyed by file and block number.
+ * The blocks of a file are kept in a bitmap, such that multi-GB files with small blocks stay cheap.
+ * Like XCache purges, eviction works on all cached blocks of the least recently used file at once.
+ */
+class BlockCacheIndex {
+
+public:
+    static BlockCacheIndex &get(const std::shared_ptr<wrench::StorageService> &cache);
+
+    static size_t getNumBlocks(const std::shared_ptr<wrench::DataFile> &file);
+    static sg_size_t getBlockSize(const std::shared_ptr<wrench::DataFile> &file, size_t block);
+    static sg_size_t getOccupiedSpace(const std::shared_ptr<wrench::StorageService> &cache);
+
+    bool hasBlock(const std::shared_ptr<wrench::DataFile> &file, size_t block) const;
+    void addBlock(const std::shared_ptr<wrench::DataFile> &file, size_t block);
+    void addFile(const std::shared_ptr<wrench::DataFile> &file);
+    void touchFile(const std::shared_ptr<wrench::DataFile> &file);
+    sg_size_t removeLRUFile();
+
+    /** @brief Number of bytes of all cached blocks */
+    sg_size_t getUsedSpace() const { return this->used_space; }
+
+private:
+    /**
+     * @brief Cached blocks of a file
+     */
+    struct Entry {
+        // one bit per block of the file
+        std::vector<uint64_t> bitmap;
+        // position in the LRU list
+        std::list<wrench::DataFile *>::iterator lru_position;
+        // bytes of the cached blocks
+        sg_size_t cached_bytes = 0;
+    };
+
+    Entry &getEntry(const std::shared_ptr<wrench::DataFile> &file);
+
+    std::unordered_map<wrench::DataFile *, Entry> entries;
+    // files ordered by last access -- front is most recently used
+    std::list<wrench::DataFile *> lru_list;
+    sg_size_t used_space = 0;
+
+    static std::map<wrench::StorageService *, BlockCacheIndex> indices;
+};
+
+#endif//S_BLOCKCACHEINDEX_H
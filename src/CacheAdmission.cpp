@@ -0,0 +1,64 @@
+#include <wrench-dev.h>
+
+#include "CacheAdmission.h"
+#include "SimpleSimulator.h"
+
+
+std::list<wrench::DataFile *> CacheAdmission::ghost_list;
+std::unordered_map<wrench::DataFile *, std::list<wrench::DataFile *>::iterator> CacheAdmission::ghost_entries;
+
+
+/**
+ * @brief Decide whether a file to be written into a cache is admitted
+ *
+ * @param policy Admission policy
+ * @param file File to be cached
+ * @param workload Name of the workload of the job reading the file
+ * @return true if the file is to be cached, false otherwise
+ */
+bool CacheAdmission::admit(const CacheAdmissionPolicy policy, const std::shared_ptr<wrench::DataFile> &file, const std::string &workload) {
+    switch (policy) {
+        case CacheAdmissionPolicy::AdmitOnSecondAccess:
+            return CacheAdmission::admitOnSecondAccess(file.get());
+        case CacheAdmissionPolicy::AdmitBySize:
+            return file->getSize() >= SimpleSimulator::cache_admission_min_size &&
+                   (SimpleSimulator::cache_admission_max_size == 0 || file->getSize() <= SimpleSimulator::cache_admission_max_size);
+        case CacheAdmissionPolicy::AdmitByName: {
+            auto const &names = SimpleSimulator::cache_admission_names;
+            const DatasetFiles *dataset = DatasetFiles::find(file.get());
+            return names.find(workload) != names.end() ||
+                   (dataset && names.find(dataset->getName()) != names.end());
+        }
+        case CacheAdmissionPolicy::AdmitByProbability: {
+            std::uniform_real_distribution<double> dist(0., 1.);
+            return dist(SimpleSimulator::gen) < SimpleSimulator::cache_admission_probability;
+        }
+        case CacheAdmissionPolicy::AdmitAlways:
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Admit a file if it was refused recently and is still remembered in the ghost list
+ * of SimpleSimulator::cache_admission_ghost_size files, remember it otherwise
+ *
+ * @param file
+ * @return true if the file is to be cached, false otherwise
+ */
+bool CacheAdmission::admitOnSecondAccess(wrench::DataFile *file) {
+    auto entry = CacheAdmission::ghost_entries.find(file);
+    if (entry != CacheAdmission::ghost_entries.end()) {
+        CacheAdmission::ghost_list.erase(entry->second);
+        CacheAdmission::ghost_entries.erase(entry);
+        return true;
+    }
+    if (SimpleSimulator::cache_admission_ghost_size == 0) return false;
+    if (CacheAdmission::ghost_list.size() >= SimpleSimulator::cache_admission_ghost_size) {
+        CacheAdmission::ghost_entries.erase(CacheAdmission::ghost_list.back());
+        CacheAdmission::ghost_list.pop_back();
+    }
+    CacheAdmission::ghost_list.push_front(file);
+    CacheAdmission::ghost_entries[file] = CacheAdmission::ghost_list.begin();
+    return false;
+}
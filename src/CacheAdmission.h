@@ -0,0 +1,32 @@
+
+
+#ifndef S_CACHEADMISSION_H
+#define S_CACHEADMISSION_H
+
+#include <list>
+#include <unordered_map>
+
+#include <wrench-dev.h>
+
+#include "DatasetFiles.h"
+#include "util/Utils.h"
+
+/**
+ * @brief Admission control deciding whether a file is written into a cache,
+ * which keeps one-shot files from polluting caches
+ */
+class CacheAdmission {
+
+public:
+    static bool admit(CacheAdmissionPolicy policy, const std::shared_ptr<wrench::DataFile> &file, const std::string &workload);
+
+private:
+    static bool admitOnSecondAccess(wrench::DataFile *file);
+
+    // files recently refused admission -- front is the most recent
+    static std::list<wrench::DataFile *> ghost_list;
+    // position of each file in the ghost list
+    static std::unordered_map<wrench::DataFile *, std::list<wrench::DataFile *>::iterator> ghost_entries;
+};
+
+#endif//S_CACHEADMISSION_H
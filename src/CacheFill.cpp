@@ -0,0 +1,134 @@
+#include <wrench-dev.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(cache_fill, "Log category for CacheFill");
+
+#include "CacheFill.h"
+#include "CacheWriter.h"
+#include "SimpleSimulator.h"
+
+
+std::map<std::pair<wrench::StorageService *, wrench::DataFile *>, std::shared_ptr<CacheFill>> CacheFill::fills;
+
+
+/**
+ * @brief Construct a new CacheFill object for a file not yet written into the cache
+ *
+ * @param cache Cache storage service the file is written to
+ * @param file File to write
+ */
+CacheFill::CacheFill(const std::shared_ptr<wrench::StorageService> &cache, const std::shared_ptr<wrench::DataFile> &file) : cache(cache),
+                                                                                                                          file(file) {
+    this->mutex = simgrid::s4u::Mutex::create();
+    this->block_available = simgrid::s4u::ConditionVariable::create();
+}
+
+/**
+ * @brief Register a fill of a file into a cache
+ *
+ * @param cache Cache storage service the file is written to
+ * @param file File to write
+ * @return the registered fill
+ *
+ * @throw std::runtime_error
+ */
+std::shared_ptr<CacheFill> CacheFill::start(const std::shared_ptr<wrench::StorageService> &cache, const std::shared_ptr<wrench::DataFile> &file) {
+    auto key = std::make_pair(cache.get(), file.get());
+    if (CacheFill::fills.find(key) != CacheFill::fills.end()) {
+        throw std::runtime_error("File " + file->getID() + " is already being written into cache " + cache->getHostname() + "!");
+    }
+    auto fill = std::make_shared<CacheFill>(cache, file);
+    CacheFill::fills[key] = fill;
+    return fill;
+}
+
+/**
+ * @brief Find the fill of a file into a cache in progress
+ *
+ * @param cache Cache storage service
+ * @param file File
+ * @return the fill in progress, or nullptr if the file isn't being written into the cache
+ */
+std::shared_ptr<CacheFill> CacheFill::find(const std::shared_ptr<wrench::StorageService> &cache, wrench::DataFile *file) {
+    auto fill = CacheFill::fills.find(std::make_pair(cache.get(), file));
+    if (fill == CacheFill::fills.end()) return nullptr;
+    return fill->second;
+}
+
+/**
+ * @brief Write bytes received from the GRID into the cache, consuming the cache's disk write bandwidth
+ * (and the network towards the cache if it is located on another host). The bytes are written by the calling job,
+ * or handed over to the cache's writer actor when SimpleSimulator::cache_write_queue is set.
+ *
+ * @param num_bytes Number of bytes received, capped to the remainder of the file
+ */
+void CacheFill::addBytes(sg_size_t num_bytes) {
+    if (this->done || this->finished) return;
+    num_bytes = std::min<sg_size_t>(num_bytes, this->file->getSize() - this->bytes_added);
+    this->bytes_added += num_bytes;
+    if (SimpleSimulator::cache_write_queue > 0) {
+        CacheWriter::write(this->cache, num_bytes, shared_from_this());
+        return;
+    }
+    if (num_bytes > 0) {
+        CacheWriter::writeNow(this->cache, simgrid::s4u::this_actor::get_host(), num_bytes);
+    }
+    this->makeAvailable(num_bytes);
+}
+
+/**
+ * @brief Account bytes written into the cache and wake up waiting readers
+ *
+ * @param num_bytes Number of bytes written
+ */
+void CacheFill::makeAvailable(const sg_size_t num_bytes) {
+    std::unique_lock<simgrid::s4u::Mutex> lock(*this->mutex);
+    if (this->done) return;
+    this->bytes_available += num_bytes;
+    WRENCH_DEBUG("%llu of %llu bytes of file %s available in cache %s", this->bytes_available, this->file->getSize(),
+                 this->file->getID().c_str(), this->cache->getHostname().c_str());
+    this->block_available->notify_all();
+    lock.unlock();
+    if (this->bytes_available >= this->file->getSize()) {
+        this->complete();
+    }
+}
+
+/**
+ * @brief Block until the first bytes of the file are available in the cache
+ *
+ * @param num_bytes Number of bytes from the start of the file needed, capped to the file size
+ */
+void CacheFill::waitForBytes(const sg_size_t num_bytes) {
+    auto needed_bytes = std::min<sg_size_t>(num_bytes, this->file->getSize());
+    std::unique_lock<simgrid::s4u::Mutex> lock(*this->mutex);
+    while (!this->done && this->bytes_available < needed_bytes) {
+        this->block_available->wait(lock);
+    }
+}
+
+/**
+ * @brief Called by the filling job when it is done with the file, also when it ends prematurely.
+ * The fill is completed once all bytes handed over to the cache's writer actor are written.
+ */
+void CacheFill::finish() {
+    if (this->finished) return;
+    this->finished = true;
+    if (SimpleSimulator::cache_write_queue > 0 && !this->done) {
+        CacheWriter::finish(this->cache, shared_from_this());
+        return;
+    }
+    this->complete();
+}
+
+/**
+ * @brief Mark the fill as done and wake up all waiting readers.
+ * If the filling job ended prematurely, the file is considered complete.
+ */
+void CacheFill::complete() {
+    std::unique_lock<simgrid::s4u::Mutex> lock(*this->mutex);
+    if (this->done) return;
+    this->done = true;
+    this->block_available->notify_all();
+    lock.unlock();
+    CacheFill::fills.erase(std::make_pair(this->cache.get(), this->file.get()));
+}
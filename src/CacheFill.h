@@ -0,0 +1,46 @@
+
+
+#ifndef S_CACHEFILL_H
+#define S_CACHEFILL_H
+
+#include <wrench-dev.h>
+
+/**
+ * @brief Progress of a file being written into a cache by the first job reading it from the GRID or an upper cache tier.
+ * Further jobs finding the file in the cache wait for the bytes they want to read to be available
+ * instead of requesting the file from the GRID again (request collapsing).
+ */
+class CacheFill : public std::enable_shared_from_this<CacheFill> {
+
+public:
+    CacheFill(const std::shared_ptr<wrench::StorageService> &cache, const std::shared_ptr<wrench::DataFile> &file);
+
+    static std::shared_ptr<CacheFill> start(const std::shared_ptr<wrench::StorageService> &cache, const std::shared_ptr<wrench::DataFile> &file);
+    static std::shared_ptr<CacheFill> find(const std::shared_ptr<wrench::StorageService> &cache, wrench::DataFile *file);
+
+    void addBytes(sg_size_t num_bytes);
+    void makeAvailable(sg_size_t num_bytes);
+    void waitForBytes(sg_size_t num_bytes);
+    void finish();
+    void complete();
+
+    [[nodiscard]] bool isDone() const { return this->done; }
+
+private:
+    std::shared_ptr<wrench::StorageService> cache;
+    std::shared_ptr<wrench::DataFile> file;
+    // bytes of the file handed over for writing into the cache
+    sg_size_t bytes_added = 0;
+    // bytes of the file already written into the cache
+    sg_size_t bytes_available = 0;
+    bool done = false;
+    // whether the filling job is done with the fill
+    bool finished = false;
+    simgrid::s4u::MutexPtr mutex;
+    simgrid::s4u::ConditionVariablePtr block_available;
+
+    // fills in progress per cache and file
+    static std::map<std::pair<wrench::StorageService *, wrench::DataFile *>, std::shared_ptr<CacheFill>> fills;
+};
+
+#endif//S_CACHEFILL_H
@@ -0,0 +1,111 @@
+#include <wrench-dev.h>
+
+#include "CachePlacement.h"
+#include "SimpleSimulator.h"
+#include "BlockCacheIndex.h"
+
+
+std::map<wrench::StorageService *, size_t> CachePlacement::active_transfers;
+
+
+/**
+ * @brief Pick the cache to write a file to
+ *
+ * @param strategy Placement strategy
+ * @param caches Reachable caches to choose from, must not be empty
+ * @param file File to place
+ * @return the chosen cache
+ */
+std::shared_ptr<wrench::StorageService> CachePlacement::pick(const CachePlacementStrategy strategy,
+                                                             const std::vector<std::shared_ptr<wrench::StorageService>> &caches,
+                                                             const std::shared_ptr<wrench::DataFile> &file) {
+    switch (strategy) {
+        case CachePlacementStrategy::HashPlacement: {
+            // Rendezvous hashing: each file has a stable home among the caches in reach,
+            // only files homed on a cache going out of reach move
+            std::shared_ptr<wrench::StorageService> chosen;
+            uint64_t best_weight = 0;
+            for (auto const &cache: caches) {
+                uint64_t weight = CachePlacement::hash(file->getID() + "@" + cache->getHostname());
+                if (!chosen || weight > best_weight) {
+                    chosen = cache;
+                    best_weight = weight;
+                }
+            }
+            return chosen;
+        }
+        case CachePlacementStrategy::FreeSpacePlacement: {
+            // Space is taken from the simulator's own bookkeeping, which avoids a request to each storage service
+            std::shared_ptr<wrench::StorageService> chosen;
+            double most_free_space = 0.;
+            for (auto const &cache: caches) {
+                double free_space = static_cast<double>(cache->getTotalSpace()) -
+                                    static_cast<double>(BlockCacheIndex::getOccupiedSpace(cache));
+                if (!chosen || free_space > most_free_space) {
+                    chosen = cache;
+                    most_free_space = free_space;
+                }
+            }
+            return chosen;
+        }
+        case CachePlacementStrategy::LeastLoadedPlacement: {
+            // Ties are broken randomly not to pile up files on the first cache
+            std::vector<std::shared_ptr<wrench::StorageService>> least_loaded;
+            size_t min_load = std::numeric_limits<size_t>::max();
+            for (auto const &cache: caches) {
+                size_t load = CachePlacement::active_transfers[cache.get()];
+                if (load < min_load) {
+                    least_loaded.clear();
+                    min_load = load;
+                }
+                if (load == min_load) least_loaded.push_back(cache);
+            }
+            std::uniform_int_distribution<size_t> pick_cache(0, least_loaded.size() - 1);
+            return least_loaded.at(pick_cache(SimpleSimulator::gen));
+        }
+        case CachePlacementStrategy::RandomPlacement:
+        default: {
+            std::uniform_int_distribution<size_t> pick_cache(0, caches.size() - 1);
+            return caches.at(pick_cache(SimpleSimulator::gen));
+        }
+    }
+}
+
+/**
+ * @brief Account a job starting to read from or fill a cache
+ *
+ * @param cache
+ */
+void CachePlacement::addTransfer(const std::shared_ptr<wrench::StorageService> &cache) {
+    CachePlacement::active_transfers[cache.get()]++;
+}
+
+/**
+ * @brief Account a job done reading from or filling a cache
+ *
+ * @param cache
+ */
+void CachePlacement::removeTransfer(const std::shared_ptr<wrench::StorageService> &cache) {
+    auto transfers = CachePlacement::active_transfers.find(cache.get());
+    if (transfers != CachePlacement::active_transfers.end() && transfers->second > 0) {
+        transfers->second--;
+    }
+}
+
+/**
+ * @brief FNV-1a hash with a final avalanche step, which unlike std::hash is stable across platforms and builds
+ *
+ * @param key
+ * @return uint64_t
+ */
+uint64_t CachePlacement::hash(const std::string &key) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto const &c: key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
@@ -0,0 +1,30 @@
+
+
+#ifndef S_CACHEPLACEMENT_H
+#define S_CACHEPLACEMENT_H
+
+#include <wrench-dev.h>
+
+#include "util/Utils.h"
+
+/**
+ * @brief Selection of the cache a file missed in all reachable caches is written to
+ */
+class CachePlacement {
+
+public:
+    static std::shared_ptr<wrench::StorageService> pick(CachePlacementStrategy strategy,
+                                                        const std::vector<std::shared_ptr<wrench::StorageService>> &caches,
+                                                        const std::shared_ptr<wrench::DataFile> &file);
+
+    static void addTransfer(const std::shared_ptr<wrench::StorageService> &cache);
+    static void removeTransfer(const std::shared_ptr<wrench::StorageService> &cache);
+
+private:
+    static uint64_t hash(const std::string &key);
+
+    // number of jobs currently reading from or filling each cache
+    static std::map<wrench::StorageService *, size_t> active_transfers;
+};
+
+#endif//S_CACHEPLACEMENT_H
@@ -0,0 +1,150 @@
+#include <wrench-dev.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(cache_writer, "Log category for CacheWriter");
+
+#include "CacheWriter.h"
+#include "CacheFill.h"
+#include "SimpleSimulator.h"
+#include "computation/AsyncRead.h"
+#include "monitoring/NetworkMonitor.h"
+
+
+std::map<wrench::StorageService *, std::unique_ptr<CacheWriter>> CacheWriter::writers;
+
+
+/**
+ * @brief Construct a new CacheWriter object and start its actor on the cache's host.
+ * The actor is a daemon, which doesn't keep the simulation alive.
+ *
+ * @param cache Cache storage service to write to
+ */
+CacheWriter::CacheWriter(const std::shared_ptr<wrench::StorageService> &cache) : cache(cache) {
+    this->mutex = simgrid::s4u::Mutex::create();
+    this->not_empty = simgrid::s4u::ConditionVariable::create();
+    this->not_full = simgrid::s4u::ConditionVariable::create();
+    this->idle = simgrid::s4u::ConditionVariable::create();
+    auto host = simgrid::s4u::Host::by_name(cache->getHostname());
+    simgrid::s4u::Actor::create("cache_writer_" + cache->getHostname(), host, [this]() { this->run(); })->daemonize();
+}
+
+/**
+ * @brief Writer of a cache, created on first use
+ *
+ * @param cache Cache storage service
+ * @return the writer
+ */
+CacheWriter &CacheWriter::get(const std::shared_ptr<wrench::StorageService> &cache) {
+    auto &writer = CacheWriter::writers[cache.get()];
+    if (!writer) {
+        writer = std::make_unique<CacheWriter>(cache);
+    }
+    return *writer;
+}
+
+/**
+ * @brief Hand data read by the calling job over to the writer of a cache,
+ * blocking while the writer's queue of SimpleSimulator::cache_write_queue requests is full
+ *
+ * @param cache Cache storage service to write to
+ * @param num_bytes Number of bytes to write
+ * @param fill Fill the data belongs to, made available once written, nullptr if no job waits for the data
+ */
+void CacheWriter::write(const std::shared_ptr<wrench::StorageService> &cache, const sg_size_t num_bytes, const std::shared_ptr<CacheFill> &fill) {
+    if (num_bytes == 0) return;
+    CacheWriter::get(cache).enqueue(Request{simgrid::s4u::this_actor::get_host(), num_bytes, fill, false});
+}
+
+/**
+ * @brief Complete a fill once the writer of a cache has written all data handed over before
+ *
+ * @param cache Cache storage service written to
+ * @param fill Fill the filling job is done with
+ */
+void CacheWriter::finish(const std::shared_ptr<wrench::StorageService> &cache, const std::shared_ptr<CacheFill> &fill) {
+    CacheWriter::get(cache).enqueue(Request{simgrid::s4u::this_actor::get_host(), 0, fill, true});
+}
+
+/**
+ * @brief Write data into a cache from the calling actor, consuming the cache's disk write bandwidth
+ * and the network towards the cache if the data comes from another host
+ *
+ * @param cache Cache storage service to write to
+ * @param source Host the data is sent from
+ * @param num_bytes Number of bytes to write
+ */
+void CacheWriter::writeNow(const std::shared_ptr<wrench::StorageService> &cache, simgrid::s4u::Host *source, const sg_size_t num_bytes) {
+    auto cache_host = simgrid::s4u::Host::by_name(cache->getHostname());
+    if (cache_host != source) {
+        simgrid::s4u::Comm::sendto(source, cache_host, num_bytes);
+    }
+    double write_start = wrench::Simulation::getCurrentSimulatedDate();
+    AsyncRead::getStorageDisk(cache->getHostname())->write(num_bytes);
+    NetworkMonitor::recordWrite(cache, num_bytes, write_start);
+}
+
+/**
+ * @brief Block the calling actor until all writers have written the data handed over so far,
+ * as the daemonized writer actors stop with the last non-daemon actor
+ */
+void CacheWriter::waitForWrites() {
+    bool drained = false;
+    while (!drained) {
+        // Writers may be created by fills completing in the meantime
+        drained = true;
+        for (auto const &entry: CacheWriter::writers) {
+            auto &writer = *entry.second;
+            std::unique_lock<simgrid::s4u::Mutex> lock(*writer.mutex);
+            while (!writer.queue.empty() || writer.busy) {
+                drained = false;
+                writer.idle->wait(lock);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Append a request to the queue, blocking while it is full
+ *
+ * @param request
+ */
+void CacheWriter::enqueue(Request request) {
+    std::unique_lock<simgrid::s4u::Mutex> lock(*this->mutex);
+    while (this->queue.size() >= SimpleSimulator::cache_write_queue) {
+        this->not_full->wait(lock);
+    }
+    this->queue.push_back(std::move(request));
+    this->not_empty->notify_all();
+}
+
+/**
+ * @brief Main loop of the writer actor, serving the queued requests in order
+ */
+void CacheWriter::run() {
+    while (true) {
+        std::unique_lock<simgrid::s4u::Mutex> lock(*this->mutex);
+        while (this->queue.empty()) {
+            this->not_empty->wait(lock);
+        }
+        Request request = std::move(this->queue.front());
+        this->queue.pop_front();
+        this->busy = true;
+        this->not_full->notify_all();
+        lock.unlock();
+
+        if (request.finish) {
+            request.fill->complete();
+        } else {
+            WRENCH_DEBUG("Writing %llu bytes into cache %s", request.num_bytes, this->cache->getHostname().c_str());
+            CacheWriter::writeNow(this->cache, request.source, request.num_bytes);
+            if (request.fill) {
+                request.fill->makeAvailable(request.num_bytes);
+            }
+        }
+
+        lock.lock();
+        this->busy = false;
+        if (this->queue.empty()) {
+            this->idle->notify_all();
+        }
+    }
+}
@@ -0,0 +1,58 @@
+
+
+#ifndef S_CACHEWRITER_H
+#define S_CACHEWRITER_H
+
+#include <deque>
+
+#include <wrench-dev.h>
+
+class CacheFill;
+
+/**
+ * @brief Writer actor of a cache, which writes the data filled into the cache onto its disk
+ * asynchronously to the jobs reading it. Jobs hand the data over through a bounded queue
+ * and only block when the queue is full.
+ */
+class CacheWriter {
+
+public:
+    explicit CacheWriter(const std::shared_ptr<wrench::StorageService> &cache);
+
+    static void write(const std::shared_ptr<wrench::StorageService> &cache, sg_size_t num_bytes, const std::shared_ptr<CacheFill> &fill);
+    static void finish(const std::shared_ptr<wrench::StorageService> &cache, const std::shared_ptr<CacheFill> &fill);
+    static void writeNow(const std::shared_ptr<wrench::StorageService> &cache, simgrid::s4u::Host *source, sg_size_t num_bytes);
+    static void waitForWrites();
+
+private:
+    /**
+     * @brief Data handed over to the writer, or the end of a fill
+     */
+    struct Request {
+        // host the data is sent from
+        simgrid::s4u::Host *source;
+        sg_size_t num_bytes;
+        // fill the data belongs to, nullptr if no job waits for the data
+        std::shared_ptr<CacheFill> fill;
+        // whether the filling job is done with the fill
+        bool finish;
+    };
+
+    static CacheWriter &get(const std::shared_ptr<wrench::StorageService> &cache);
+
+    void enqueue(Request request);
+    void run();
+
+    std::shared_ptr<wrench::StorageService> cache;
+    std::deque<Request> queue;
+    // whether the actor is serving a request taken from the queue
+    bool busy = false;
+    simgrid::s4u::MutexPtr mutex;
+    simgrid::s4u::ConditionVariablePtr not_empty;
+    simgrid::s4u::ConditionVariablePtr not_full;
+    simgrid::s4u::ConditionVariablePtr idle;
+
+    static std::map<wrench::StorageService *, std::unique_ptr<CacheWriter>> writers;
+};
+
+#endif//S_CACHEWRITER_H
@@ -1,4 +1,7 @@
 #include "Dataset.h"
+#include "SimpleSimulator.h"
+#include "sampling/ParallelFor.h"
+#include "sampling/Philox.h"
 
 /**
  * @brief
@@ -7,7 +10,7 @@
  * @param num_files: number of tasks
  * @param file_size: JSON description of the file size distribution
  * @param name_suffix: dataset name
- * @param generator: random number generator objects to draw from
+ * @param seed: seed of the random streams the file sizes are drawn from
  *
  * @throw std::runtime_error
  */
@@ -16,42 +19,53 @@ Dataset::Dataset(
         const size_t num_files,
         const nlohmann::json &file_size,
         const std::string& name_suffix,
-        const std::mt19937 &generator) {
-    this->generator = generator;
-    std::string potential_separator = (name_suffix.empty() ? "" : "_");
-
-    this->size_dist = createRNG(file_size);
-    for (size_t f = 0; f < num_files; f++) {
-        // Sample input file sizes
-        double dsize = size_dist(this->generator);
-        while (dsize < 0.) dsize = size_dist(this->generator);
-        // Convert the input file size to an integral number of bytes
-        auto size_in_bytes = static_cast<sg_size_t>(dsize);
-        this->files.push_back(wrench::Simulation::  addFile("infile_" + name_suffix + potential_separator + std::to_string(f), size_in_bytes));
+        const unsigned int seed) {
+    this->size_dist = Sampler(file_size, false, 0.);
+    std::cerr << file_size["type"] << ": ";
+    auto type = file_size["type"].get<std::string>();
+    if (type == "gaussian") {
+        std::cerr << "ave: " << file_size["average"] << ", stddev: " << file_size["sigma"] << std::endl;
+    } else if (type == "histogram") {
+        std::cerr << "bins: " << file_size["bins"] << ", weights: " << file_size["counts"] << std::endl;
+    } else if (type == "lognormal") {
+        std::cerr << "mu: " << file_size["mu"] << ", sigma: " << file_size["sigma"] << std::endl;
+    } else if (type == "exponential") {
+        std::cerr << "lambda: " << file_size["lambda"] << std::endl;
+    } else if (type == "empirical") {
+        std::cerr << file_size["values"].size() << " values" << std::endl;
+    } else {
+        std::cerr << std::endl;
     }
+    // Sample non-negative input file sizes in parallel, each file from its own stream,
+    // whereas files are only registered with the simulation once jobs access them
+    std::vector<sg_size_t> sizes_in_bytes(num_files);
+    std::string stream_name = "dataset/" + name_suffix;
+    parallelFor(num_files, SimpleSimulator::sampling_threads, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; f++) {
+            PhiloxEngine stream(seed, stream_name, f, 0);
+            // Convert the input file size to an integral number of bytes
+            sizes_in_bytes[f] = static_cast<sg_size_t>(this->size_dist(stream));
+        }
+    });
     this->hostnames = hostnames;
     this->name = name_suffix;
+    this->files = std::make_shared<DatasetFiles>(this->name, std::move(sizes_in_bytes));
 }
 
-std::function<double(std::mt19937 &)> Dataset::createRNG(nlohmann::json json) {
-    std::cerr << json["type"] << ": ";
-    std::function<double(std::mt19937 &)> dist;
-    if (json["type"].get<std::string>() == "gaussian") {
-        double ave = json["average"].get<double>();
-        double sigma = json["sigma"].get<double>();
-        std::cerr << "ave: " << ave << ", stddev: " << sigma << std::endl;
-        dist = [ave, sigma](std::mt19937 &generator) {
-            return std::normal_distribution<double>(ave, sigma)(generator);
-        };
-    } else if (json["type"].get<std::string>() == "histogram") {
-        auto bins = json["bins"].get<std::vector<double>>();
-        auto weights = json["counts"].get<std::vector<int>>();
-        std::cerr << "bins: " << json["bins"] << ", weights: " << json["counts"] << std::endl;
-        dist = [bins, weights](std::mt19937 &generator) {
-            return std::piecewise_constant_distribution<double>(bins.begin(), bins.end(), weights.begin())(generator);
-        };
-    } else {
-        throw std::runtime_error("Random number generation for type " + json["type"].get<std::string>() + " not implemented!");
-    }
-    return dist;
-}
\ No newline at end of file
+/**
+ * @brief Create a dataset of files whose sizes have been sampled before
+ *
+ * @param hostnames: list of hostname on which the dataset is hosted
+ * @param file_sizes: sizes of the files in bytes
+ * @param num_files: number of files
+ * @param name_suffix: dataset name
+ */
+Dataset::Dataset(
+        const std::vector<std::string> &hostnames,
+        const sg_size_t *file_sizes,
+        const size_t num_files,
+        const std::string &name_suffix) {
+    this->hostnames = hostnames;
+    this->name = name_suffix;
+    this->files = std::make_shared<DatasetFiles>(this->name, std::vector<sg_size_t>(file_sizes, file_sizes + num_files));
+}
@@ -2,8 +2,10 @@
 #ifndef S_DATASET_H
 #define S_DATASET_H
 
+#include "DatasetFiles.h"
 #include "JobSpecification.h"
 #include "util/Utils.h"
+#include "sampling/Sampler.h"
 
 class Dataset {
 public:
@@ -13,15 +15,18 @@ public:
             size_t num_files,
             const nlohmann::json &file_size,
             const std::string &name_suffix,
-            const std::mt19937 &generator);
+            unsigned int seed);
+    Dataset(
+            const std::vector<std::string> &hostnames,
+            const sg_size_t *file_sizes,
+            size_t num_files,
+            const std::string &name_suffix);
     std::vector<std::string> hostnames;
-    std::vector<std::shared_ptr<wrench::DataFile>> files;
+    std::shared_ptr<DatasetFiles> files;
     std::string name;
 
 private:
-    std::function<double(std::mt19937 &)> size_dist;
-    static std::function<double(std::mt19937 &)> createRNG(nlohmann::json json);
-    std::mt19937 generator;
+    Sampler size_dist;
 };
 
 
@@ -0,0 +1,117 @@
+#include "DatasetFiles.h"
+
+#include "SimpleSimulator.h"
+
+
+std::unordered_map<wrench::DataFile *, const DatasetFiles *> DatasetFiles::owners;
+
+
+/**
+ * @brief Create the files of a dataset without registering any of them
+ *
+ * @param name Name of the dataset, which is part of the files' IDs
+ * @param sizes Sizes of the files in bytes
+ * @param outputs Whether the files are the output-files of a workload, which don't exist before they are written
+ */
+DatasetFiles::DatasetFiles(std::string name, std::vector<sg_size_t> sizes, const bool outputs)
+    : name(std::move(name)), sizes(std::move(sizes)), prefix(outputs ? "outfile" : "infile") {
+    if (outputs) {
+        this->available.assign(this->sizes.size(), false);
+    }
+}
+
+/**
+ * @brief ID of a file, "infile_<dataset>_<index>" or "outfile_<workload>_<index>"
+ *
+ * @param index Index of the file in the dataset
+ * @return std::string
+ */
+std::string DatasetFiles::getID(const size_t index) const {
+    return DatasetFiles::formatID(this->prefix, this->name, index);
+}
+
+/**
+ * @brief ID of a file of a dataset or workload, also for output-files not held by a DatasetFiles
+ *
+ * @param prefix "infile" or "outfile"
+ * @param name Name of the dataset or workload
+ * @param index Index of the file
+ * @return std::string
+ */
+std::string DatasetFiles::formatID(const std::string &prefix, const std::string &name, const size_t index) {
+    return prefix + "_" + name + (name.empty() ? "" : "_") + std::to_string(index);
+}
+
+/**
+ * @brief Find the index of a file by its ID
+ *
+ * @param id ID of the file
+ * @param index Index of the file in the dataset
+ * @return true if the ID is the one of a file of this dataset, false otherwise
+ */
+bool DatasetFiles::findIndex(const std::string &id, size_t &index) const {
+    std::string prefix = this->prefix + "_" + this->name + (this->name.empty() ? "" : "_");
+    if (id.size() <= prefix.size() || id.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    size_t parsed = 0;
+    for (size_t c = prefix.size(); c < id.size(); c++) {
+        if (id[c] < '0' || id[c] > '9') return false;
+        parsed = parsed * 10 + static_cast<size_t>(id[c] - '0');
+        if (parsed >= this->sizes.size()) return false;
+    }
+    index = parsed;
+    return true;
+}
+
+/**
+ * @brief Get a file, registering it with the simulation and creating it on the dataset's storages on first access
+ *
+ * @param index Index of the file in the dataset
+ * @return the file
+ */
+const std::shared_ptr<wrench::DataFile> &DatasetFiles::get(const size_t index) {
+    auto it = this->registered.find(index);
+    if (it != this->registered.end()) {
+        return it->second;
+    }
+    auto file = wrench::Simulation::addFile(this->getID(index), this->sizes[index]);
+    DatasetFiles::owners[file.get()] = this;
+    this->stage(file);
+    return this->registered.emplace(index, std::move(file)).first->second;
+}
+
+/**
+ * @brief Set the storages holding the dataset, on which the files registered so far and all later ones are created
+ *
+ * @param storage_services GRID storages hosting the dataset
+ */
+void DatasetFiles::stageOn(const std::vector<std::shared_ptr<wrench::StorageService>> &storage_services) {
+    this->storage_services = storage_services;
+    for (auto const &entry: this->registered) {
+        this->stage(entry.second);
+    }
+}
+
+/**
+ * @brief Create a file on the storages holding the dataset
+ *
+ * @param file File to create
+ */
+void DatasetFiles::stage(const std::shared_ptr<wrench::DataFile> &file) const {
+    for (auto const &storage_service: this->storage_services) {
+        wrench::StorageService::createFileAtLocation(wrench::FileLocation::LOCATION(storage_service, file));
+        SimpleSimulator::global_file_map[storage_service].touchFile(file.get());
+    }
+}
+
+/**
+ * @brief Find the dataset a file belongs to
+ *
+ * @param file Registered file
+ * @return the dataset, nullptr if the file is neither a file of a dataset nor an output-file read downstream
+ */
+const DatasetFiles *DatasetFiles::find(wrench::DataFile *file) {
+    auto it = DatasetFiles::owners.find(file);
+    return it != DatasetFiles::owners.end() ? it->second : nullptr;
+}
@@ -0,0 +1,77 @@
+
+
+#ifndef S_DATASETFILES_H
+#define S_DATASETFILES_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <wrench-dev.h>
+
+/**
+ * @brief Files of a dataset, whose sizes are kept in a packed array. The WRENCH DataFile of a file,
+ * with its ID formatted on demand, is registered with the simulation and created on the dataset's storages
+ * only when the file is first accessed, so that files no job touches cost nothing but their size.
+ * The output-files of a workload are held the same way, so that downstream workloads can read them,
+ * but they only become available once the job writing them has completed.
+ */
+class DatasetFiles {
+
+public:
+    DatasetFiles(std::string name, std::vector<sg_size_t> sizes, bool outputs = false);
+
+    /** @brief Number of files */
+    size_t size() const { return this->sizes.size(); }
+
+    /** @brief Size of a file in bytes, without registering it */
+    sg_size_t getSize(size_t index) const { return this->sizes[index]; }
+
+    /** @brief Sizes of all files in bytes */
+    const std::vector<sg_size_t> &getSizes() const { return this->sizes; }
+
+    /** @brief Name of the dataset */
+    const std::string &getName() const { return this->name; }
+
+    /** @brief Number of files registered with the simulation so far */
+    size_t getNumRegistered() const { return this->registered.size(); }
+
+    /** @brief Whether a file exists, which output-files only do once they have been written */
+    bool isAvailable(size_t index) const { return this->available.empty() || this->available[index]; }
+
+    /** @brief Mark an output-file as written */
+    void setAvailable(size_t index) { this->available[index] = true; }
+
+    std::string getID(size_t index) const;
+
+    static std::string formatID(const std::string &prefix, const std::string &name, size_t index);
+
+    bool findIndex(const std::string &id, size_t &index) const;
+
+    const std::shared_ptr<wrench::DataFile> &get(size_t index);
+
+    void stageOn(const std::vector<std::shared_ptr<wrench::StorageService>> &storage_services);
+
+    static const DatasetFiles *find(wrench::DataFile *file);
+
+private:
+    std::string name;
+    std::vector<sg_size_t> sizes;
+    // "infile" for datasets, "outfile" for the output-files of a workload
+    std::string prefix;
+    // which output-files have been written, empty for datasets whose files all exist from the start
+    std::vector<bool> available;
+
+    // files registered with the simulation by their index
+    std::unordered_map<size_t, std::shared_ptr<wrench::DataFile>> registered;
+    // storages holding the dataset, on which files are created when registered
+    std::vector<std::shared_ptr<wrench::StorageService>> storage_services;
+
+    void stage(const std::shared_ptr<wrench::DataFile> &file) const;
+
+    // dataset each registered file belongs to
+    static std::unordered_map<wrench::DataFile *, const DatasetFiles *> owners;
+};
+
+#endif//S_DATASETFILES_H
@@ -0,0 +1,101 @@
+#include "FileRange.h"
+
+#include <algorithm>
+#include <limits>
+
+
+std::deque<FileList> FileArena::file_lists;
+std::deque<std::vector<uint32_t>> FileArena::index_lists;
+
+
+/**
+ * @brief Append the files of a dataset to the list
+ *
+ * @param dataset Files of the dataset, which have to outlive the list
+ */
+void FileList::addDataset(DatasetFiles *dataset) {
+    this->datasets.push_back(dataset);
+    this->offsets.push_back(this->num_files);
+    this->num_files += dataset->size();
+}
+
+/**
+ * @brief Find the dataset a file in the list belongs to
+ *
+ * @param i Index of the file in the list
+ * @param index Index of the file in its dataset
+ * @return the dataset
+ */
+DatasetFiles *FileList::locate(const size_t i, size_t &index) const {
+    if (this->datasets.size() == 1) {
+        index = i;
+        return this->datasets.front();
+    }
+    size_t d = std::upper_bound(this->offsets.begin(), this->offsets.end(), i) - this->offsets.begin() - 1;
+    index = i - this->offsets[d];
+    return this->datasets[d];
+}
+
+/**
+ * @brief Find a dataset in the list by its name
+ *
+ * @param name Name of the dataset
+ * @param offset Index of the first file of the dataset in the list
+ * @return the dataset, nullptr if it is not in the list
+ */
+DatasetFiles *FileList::findDataset(const std::string &name, size_t &offset) const {
+    for (size_t d = 0; d < this->datasets.size(); d++) {
+        if (this->datasets[d]->getName() == name) {
+            offset = this->offsets[d];
+            return this->datasets[d];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Find a file in the list by its ID without registering any file
+ *
+ * @param id ID of the file
+ * @param i Index of the file in the list
+ * @return true if the file is in the list, false otherwise
+ */
+bool FileList::findFile(const std::string &id, size_t &i) const {
+    for (size_t d = 0; d < this->datasets.size(); d++) {
+        size_t index;
+        if (this->datasets[d]->findIndex(id, index)) {
+            i = this->offsets[d] + index;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * @brief Add a file list for job input views to point into
+ *
+ * @param files Files, addressed by 32-bit indices
+ * @return the file list in the arena
+ *
+ * @throw std::runtime_error
+ */
+const FileList *FileArena::addFileList(FileList files) {
+    if (files.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Job input-files can only be drawn from up to " +
+                                 std::to_string(std::numeric_limits<uint32_t>::max()) + " files!");
+    }
+    FileArena::file_lists.push_back(std::move(files));
+    return &FileArena::file_lists.back();
+}
+
+/**
+ * @brief Allocate a zero-initialized index list for job input views to point into
+ *
+ * @param num_indices Number of indices
+ * @return the first index in the arena
+ */
+uint32_t *FileArena::allocateIndices(const size_t num_indices) {
+    FileArena::index_lists.emplace_back(num_indices, 0);
+    return FileArena::index_lists.back().data();
+}
@@ -0,0 +1,187 @@
+
+
+#ifndef S_FILERANGE_H
+#define S_FILERANGE_H
+
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <wrench-dev.h>
+
+#include "DatasetFiles.h"
+
+/**
+ * @brief The files of one or more datasets, concatenated and addressed by a single index
+ */
+class FileList {
+
+public:
+    void addDataset(DatasetFiles *dataset);
+
+    /** @brief Number of files */
+    size_t size() const { return this->num_files; }
+
+    /**
+     * @brief Get a file, registering it with the simulation on first access
+     *
+     * @param i Index of the file in the list
+     * @return the file
+     */
+    const std::shared_ptr<wrench::DataFile> &getRegistered(size_t i) const {
+        size_t index;
+        DatasetFiles *dataset = this->locate(i, index);
+        return dataset->get(index);
+    }
+
+    /**
+     * @brief Size of a file, without registering it
+     *
+     * @param i Index of the file in the list
+     * @return size in bytes
+     */
+    sg_size_t getSize(size_t i) const {
+        size_t index;
+        return this->locate(i, index)->getSize(index);
+    }
+
+    DatasetFiles *locate(size_t i, size_t &index) const;
+
+    bool findFile(const std::string &id, size_t &i) const;
+
+    DatasetFiles *findDataset(const std::string &name, size_t &offset) const;
+
+private:
+    std::vector<DatasetFiles *> datasets;
+    // index of the first file of each dataset in the list
+    std::vector<size_t> offsets;
+    size_t num_files = 0;
+};
+
+/**
+ * @brief Read-only view onto the input-files of a job, which are either a contiguous range
+ * of a shared file list, wrapping around its end, or a list of indices into it.
+ * Copying a view neither copies file handles nor touches their reference counts,
+ * and files are only registered with the simulation when the view is dereferenced.
+ */
+class FileRange {
+
+public:
+    FileRange() = default;
+
+    /**
+     * @brief View a contiguous range of a file list, wrapping around its end
+     *
+     * @param files File list, which has to outlive the view
+     * @param offset Position of the first file
+     * @param count Number of files
+     */
+    FileRange(const FileList *files, size_t offset, size_t count)
+        : files(files), offset(offset), count(count) {}
+
+    /**
+     * @brief View the files of a file list at the given indices
+     *
+     * @param files File list, which has to outlive the view
+     * @param indices Indices of the files, which have to outlive the view
+     * @param count Number of files
+     */
+    FileRange(const FileList *files, const uint32_t *indices, size_t count)
+        : files(files), indices(indices), count(count) {}
+
+    /**
+     * @brief View the files of a file list at the given indices, which are released with the last view onto them
+     *
+     * @param files File list, which has to outlive the view
+     * @param indices Indices of the files
+     */
+    FileRange(const FileList *files, std::shared_ptr<const std::vector<uint32_t>> indices)
+        : files(files), indices(indices->data()), count(indices->size()), owned_indices(std::move(indices)) {}
+
+    /** @brief The i-th file in the view, registering it with the simulation on first access */
+    const std::shared_ptr<wrench::DataFile> &getRegistered(size_t i) const {
+        return this->files->getRegistered(this->position(i));
+    }
+
+    /** @brief Size of the i-th file in the view, without registering it */
+    sg_size_t getSize(size_t i) const { return this->files->getSize(this->position(i)); }
+
+    /** @brief Index of the i-th file in the view in the viewed file list */
+    size_t position(size_t i) const {
+        if (this->indices) {
+            return this->indices[i];
+        }
+        size_t position = this->offset + i;
+        return position < this->files->size() ? position : position % this->files->size();
+    }
+
+    /** @brief The viewed file list */
+    const FileList *getFileList() const { return this->files; }
+
+    size_t size() const { return this->count; }
+
+    bool empty() const { return this->count == 0; }
+
+    /**
+     * @brief Iterator over the files in the view, registering each file with the simulation when dereferenced
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::shared_ptr<wrench::DataFile>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        const_iterator(const FileRange *range, size_t i) : range(range), i(i) {}
+
+        reference operator*() const { return this->range->getRegistered(this->i); }
+        pointer operator->() const { return &this->range->getRegistered(this->i); }
+        const_iterator &operator++() {
+            this->i++;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            this->i++;
+            return previous;
+        }
+        bool operator==(const const_iterator &other) const { return this->i == other.i; }
+        bool operator!=(const const_iterator &other) const { return this->i != other.i; }
+
+    private:
+        const FileRange *range;
+        size_t i;
+    };
+
+    const_iterator begin() const { return {this, 0}; }
+
+    const_iterator end() const { return {this, this->count}; }
+
+private:
+    const FileList *files = nullptr;
+    const uint32_t *indices = nullptr;
+    size_t offset = 0;
+    size_t count = 0;
+    // indices owned by the views onto them, for jobs created one at a time
+    std::shared_ptr<const std::vector<uint32_t>> owned_indices;
+};
+
+/**
+ * @brief Arena holding the file lists and index lists job input views point into for the whole simulation
+ */
+class FileArena {
+
+public:
+    static const FileList *addFileList(FileList files);
+
+    static uint32_t *allocateIndices(size_t num_indices);
+
+private:
+    // deques keep the lists in place when more are added
+    static std::deque<FileList> file_lists;
+    static std::deque<std::vector<uint32_t>> index_lists;
+};
+
+#endif//S_FILERANGE_H
@@ -2,6 +2,8 @@
 
 #include "JobScheduler.h"
 #include "WorkloadExecutionController.h"
+#include "monitoring/Heartbeat.h"
+#include "monitoring/Profiler.h"
 
 /**
  * @brief Constructor
@@ -48,6 +50,9 @@ void JobScheduler::jobDone(const std::shared_ptr<wrench::CompoundJob> &job) {
  * @brief A method that should be invoked whenever there may be schedulable jobs
  */
 void JobScheduler::schedule() {
+    // Counted regardless of the profiling switches, as the heartbeat reports the scheduler passes too
+    Profiler::counters[ProfilingCounter::ScheduleCalls]++;
+    Heartbeat::poll();
 
     if (this->total_num_idle_cores == 0) {
         return;
@@ -63,6 +68,7 @@ void JobScheduler::schedule() {
         // Loop through all the jobs in the workload in sequence
         std::vector<std::string> scheduled_jobs;
         for (const auto &job_spec: ec->get_workload_spec()) {
+            DCSIM_PROFILE_COUNT(JobsScanned, 1);
             auto job_name = job_spec.first;
             auto num_cores = job_spec.second.cores;
             auto total_ram = job_spec.second.total_mem;
@@ -6,6 +6,7 @@
 #include <wrench-dev.h>
 
 #include "util/Utils.h"
+#include "FileRange.h"
 
 /**
  * @brief Container to hold all job specific information
@@ -16,11 +17,17 @@ public:
     // identifier
     std::string jobid;
     // Input files to process
-    std::vector<std::shared_ptr<wrench::DataFile>> infiles;
-    // Output file to write by the job
+    FileRange infiles;
+    // Output file to write by the job, registered with the simulation when the job is submitted
     std::shared_ptr<wrench::DataFile> outfile;
-    // Desired destination of the output file to be written to
-    std::shared_ptr<wrench::FileLocation> outfile_destination;
+    // Size of the output file
+    sg_size_t outfile_size;
+    // Cache the output file is staged out onto before its upload, nullptr if written to its GRID storage directly
+    std::shared_ptr<wrench::StorageService> outfile_staging;
+    // Output files of the workload the output file belongs to, if downstream workloads may read it
+    DatasetFiles *outfiles = nullptr;
+    // Index of the output file in the output files of the workload
+    size_t outfile_index = 0;
     // Number of cores to run on
     int cores;
     // Total number of FLOPS to be computed for the job to finish
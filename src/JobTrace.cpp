@@ -0,0 +1,356 @@
+#include "JobTrace.h"
+
+#include <cstring>
+#include <sstream>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(job_trace, "Log category for JobTrace");
+
+
+constexpr char JobTrace::magic[8];
+constexpr uint32_t JobTrace::version;
+
+
+/**
+ * @brief Open a job trace, which is read as binary trace if it starts with the magic number
+ * and as CSV trace with a header line naming its columns otherwise
+ *
+ * @param path Path of the trace file
+ * @param lookahead Maximal number of jobs read ahead to bring them into submission-time order
+ * @param core_speed FLOPS per second of CPU time, used for traces recording CPU times instead of FLOPS
+ * @param lfn_dataset Dataset whose files input-files not named like DCSim files (e.g. the LFNs of a real job history)
+ * are assigned to on first sight, none if empty
+ *
+ * @throw std::runtime_error
+ */
+JobTrace::JobTrace(const std::string &path, const size_t lookahead, const double core_speed, const std::string &lfn_dataset) {
+    this->path = path;
+    this->lookahead = std::max<size_t>(lookahead, 1);
+    this->core_speed = core_speed;
+    this->lfn_dataset = lfn_dataset;
+
+    this->in.open(path, std::ios::in | std::ios::binary);
+    if (!this->in.is_open()) {
+        throw std::runtime_error("Job trace " + path + " could not be opened!");
+    }
+
+    char header[sizeof(JobTrace::magic)] = {};
+    this->in.read(header, sizeof(header));
+    if (this->in.gcount() == sizeof(header) && std::memcmp(header, JobTrace::magic, sizeof(header)) == 0) {
+        this->binary = true;
+        uint32_t file_version = 0;
+        this->in.read(reinterpret_cast<char *>(&file_version), sizeof(file_version));
+        if (!this->in || file_version != JobTrace::version) {
+            throw std::runtime_error("Job trace " + path + " has unsupported version " + std::to_string(file_version) +
+                                     ", expected " + std::to_string(JobTrace::version));
+        }
+    } else {
+        this->in.clear();
+        this->in.seekg(0);
+        std::string line;
+        while (line.empty() && std::getline(this->in, line)) {
+            this->line_number++;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+        }
+        if (line.empty()) {
+            throw std::runtime_error("Job trace " + path + " is empty!");
+        }
+        this->parseCSVHeader(line);
+    }
+
+    this->fillBuffer();
+    if (!this->buffer.empty()) {
+        this->first_submit_time = this->buffer.top().record.submit_time;
+    }
+}
+
+/**
+ * @brief Determine the column of each field from the header line of a CSV trace
+ *
+ * @param line Header line
+ *
+ * @throw std::runtime_error
+ */
+void JobTrace::parseCSVHeader(const std::string &line) {
+    std::stringstream header(line);
+    std::string column;
+    for (size_t i = 0; std::getline(header, column, ','); i++) {
+        this->columns[column] = i;
+    }
+    for (auto const &mandatory: {"submit_time", "cores", "memory"}) {
+        if (this->columns.find(mandatory) == this->columns.end()) {
+            throw std::runtime_error("Job trace " + this->path + " lacks the column " + mandatory);
+        }
+    }
+    if (this->columns.find("flops") == this->columns.end()) {
+        if (this->columns.find("cpu_time") == this->columns.end()) {
+            throw std::runtime_error("Job trace " + this->path + " needs a flops or a cpu_time column");
+        }
+        if (this->core_speed <= 0.) {
+            throw std::runtime_error("Job trace " + this->path + " records CPU times, which need a positive core_speed to be converted into FLOPS");
+        }
+    }
+}
+
+/**
+ * @brief Set the files of the input datasets and upstream workloads of the workload,
+ * onto which the input-files of the trace are mapped by name
+ *
+ * @param all_files Input-files of the workload
+ *
+ * @throw std::runtime_error
+ */
+void JobTrace::mapFiles(FileList all_files) {
+    this->resolve_files = true;
+    this->files = FileArena::addFileList(std::move(all_files));
+    if (!this->lfn_dataset.empty()) {
+        DatasetFiles *dataset = this->files->findDataset(this->lfn_dataset, this->lfn_offset);
+        if (!dataset) {
+            throw std::runtime_error("The LFN dataset " + this->lfn_dataset + " of job trace " + this->path +
+                                     " is not an infile dataset of the workload!");
+        }
+        this->lfn_count = dataset->size();
+    }
+}
+
+/**
+ * @brief Map an input-file not named like any DCSim file onto the LFN dataset,
+ * assigning each distinct name the next file of the dataset on first sight
+ *
+ * @param name Name of the input-file in the trace
+ * @param i Index of the file in the file list
+ * @return true if the name is mapped, false without LFN dataset
+ *
+ * @throw std::runtime_error
+ */
+bool JobTrace::mapLFN(const std::string &name, size_t &i) {
+    if (this->lfn_count == 0) {
+        return false;
+    }
+    auto lfn = this->lfn_indices.find(name);
+    if (lfn == this->lfn_indices.end()) {
+        if (this->next_lfn == this->lfn_count) {
+            throw std::runtime_error("Job trace " + this->path + " reads more distinct input-files than the " +
+                                     std::to_string(this->lfn_count) + " files of its LFN dataset " + this->lfn_dataset);
+        }
+        lfn = this->lfn_indices.emplace(name, static_cast<uint32_t>(this->lfn_offset + this->next_lfn++)).first;
+    }
+    i = lfn->second;
+    return true;
+}
+
+/**
+ * @brief Read the next job in trace order
+ *
+ * @param record Job read
+ * @return true if a job was read, false at the end of the trace
+ */
+bool JobTrace::readRecord(TraceRecord &record) {
+    if (this->exhausted) {
+        return false;
+    }
+    bool read = this->binary ? this->readBinaryRecord(record) : this->readCSVRecord(record);
+    if (!read) {
+        this->exhausted = true;
+        this->in.close();
+        return false;
+    }
+    if (record.jobid.empty()) {
+        record.jobid = std::to_string(this->num_read);
+    }
+    this->num_read++;
+    return true;
+}
+
+/**
+ * @brief Read the next line of a CSV trace, skipping empty lines.
+ * Input-files are given as a single column, separated by semicolons.
+ *
+ * @param record Job read
+ * @return true if a job was read, false at the end of the trace
+ *
+ * @throw std::runtime_error
+ */
+bool JobTrace::readCSVRecord(TraceRecord &record) {
+    std::string line;
+    do {
+        if (!std::getline(this->in, line)) {
+            return false;
+        }
+        this->line_number++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+    } while (line.empty());
+
+    std::vector<std::string> fields;
+    std::stringstream row(line);
+    std::string field;
+    while (std::getline(row, field, ',')) {
+        fields.push_back(field);
+    }
+    auto get = [&](const std::string &column) -> const std::string * {
+        auto it = this->columns.find(column);
+        if (it == this->columns.end() || it->second >= fields.size() || fields[it->second].empty()) {
+            return nullptr;
+        }
+        return &fields[it->second];
+    };
+
+    try {
+        record = TraceRecord();
+        if (auto jobid = get("job_id")) record.jobid = *jobid;
+        if (!get("submit_time") || !get("cores") || !get("memory")) {
+            throw std::invalid_argument("missing submit_time, cores or memory");
+        }
+        record.submit_time = std::stod(*get("submit_time"));
+        record.cores = std::stoi(*get("cores"));
+        record.memory = std::stoull(*get("memory"));
+        if (auto flops = get("flops")) {
+            record.flops = std::stod(*flops);
+        } else if (auto cpu_time = get("cpu_time")) {
+            record.flops = std::stod(*cpu_time) * this->core_speed;
+        } else {
+            throw std::invalid_argument("missing flops or cpu_time");
+        }
+        if (auto outfile_size = get("outfile_size")) record.outfile_size = std::stoull(*outfile_size);
+        if (auto infiles = get("infiles")) {
+            std::stringstream names(*infiles);
+            std::string name;
+            while (std::getline(names, name, ';')) {
+                if (!name.empty()) record.infiles.push_back(name);
+            }
+        }
+    } catch (std::logic_error &e) {
+        throw std::runtime_error("Job trace " + this->path + ", line " + std::to_string(this->line_number) + ": " + e.what());
+    }
+    return true;
+}
+
+/**
+ * @brief Read the next record of a binary trace. Each record consists of the job ID,
+ * the submission time, the cores, the FLOPS, the memory, the output-file size and the input-files,
+ * with strings and lists prefixed by their 32-bit length, in the byte order of the host.
+ *
+ * @param record Job read
+ * @return true if a job was read, false at the end of the trace
+ *
+ * @throw std::runtime_error
+ */
+bool JobTrace::readBinaryRecord(TraceRecord &record) {
+    auto read = [&](void *data, size_t size) {
+        this->in.read(static_cast<char *>(data), static_cast<std::streamsize>(size));
+        if (!this->in) {
+            throw std::runtime_error("Job trace " + this->path + " is truncated after " + std::to_string(this->num_read) + " jobs");
+        }
+    };
+    auto read_string = [&](std::string &s) {
+        uint32_t length = 0;
+        read(&length, sizeof(length));
+        s.resize(length);
+        if (length > 0) read(&s[0], length);
+    };
+
+    // A clean end of file may only occur before a record
+    if (this->in.peek() == std::char_traits<char>::eof()) {
+        return false;
+    }
+    record = TraceRecord();
+    uint32_t cores = 0;
+    uint64_t memory = 0;
+    uint64_t outfile_size = 0;
+    uint32_t num_infiles = 0;
+    read_string(record.jobid);
+    read(&record.submit_time, sizeof(record.submit_time));
+    read(&cores, sizeof(cores));
+    read(&record.flops, sizeof(record.flops));
+    read(&memory, sizeof(memory));
+    read(&outfile_size, sizeof(outfile_size));
+    read(&num_infiles, sizeof(num_infiles));
+    record.cores = static_cast<int>(cores);
+    record.memory = static_cast<sg_size_t>(memory);
+    record.outfile_size = static_cast<sg_size_t>(outfile_size);
+    record.infiles.resize(num_infiles);
+    for (auto &name: record.infiles) {
+        read_string(name);
+    }
+    return true;
+}
+
+/**
+ * @brief Read ahead until the buffer holds lookahead jobs or the trace is exhausted
+ */
+void JobTrace::fillBuffer() {
+    while (this->buffer.size() < this->lookahead) {
+        TraceRecord record;
+        if (!this->readRecord(record)) {
+            return;
+        }
+        this->buffer.push({std::move(record), this->num_read});
+    }
+}
+
+/**
+ * @brief Whether there are jobs left to replay
+ */
+bool JobTrace::hasNext() {
+    this->fillBuffer();
+    return !this->buffer.empty();
+}
+
+/**
+ * @brief Submission time of the next job, relative to the submission of the first job in the trace
+ *
+ * @throw std::runtime_error
+ */
+double JobTrace::peekSubmitTime() {
+    if (!this->hasNext()) {
+        throw std::runtime_error("No jobs left in job trace " + this->path);
+    }
+    return this->buffer.top().record.submit_time - this->first_submit_time;
+}
+
+/**
+ * @brief Replay the next job
+ *
+ * @param name_suffix Name of the workload, distinguishing its jobs and files from the ones of other workloads
+ * @return JobSpecification
+ *
+ * @throw std::runtime_error
+ */
+JobSpecification JobTrace::next(const std::string &name_suffix) {
+    if (!this->hasNext()) {
+        throw std::runtime_error("No jobs left in job trace " + this->path);
+    }
+    TraceRecord record = this->buffer.top().record;
+    this->buffer.pop();
+    if (record.submit_time < this->last_submit_time) {
+        // Submitted jobs can't be taken back, so the job is submitted as early as still possible
+        WRENCH_WARN("Job %s in job trace %s is submitted earlier than jobs preceding it by more than the lookahead of %zu jobs, delaying it by %f s",
+                    record.jobid.c_str(), this->path.c_str(), this->lookahead, this->last_submit_time - record.submit_time);
+        record.submit_time = this->last_submit_time;
+    }
+    this->last_submit_time = record.submit_time;
+
+    std::string potential_separator = (name_suffix.empty() ? "" : "_");
+    JobSpecification job_specification;
+    job_specification.jobid = "job_" + name_suffix + potential_separator + record.jobid;
+    job_specification.cores = std::max(record.cores, 1);
+    job_specification.total_flops = record.flops;
+    job_specification.total_mem = record.memory;
+    job_specification.outfile_size = record.outfile_size;
+    job_specification.outfile_index = this->num_replayed++;
+    if (this->resolve_files) {
+        // The indices are released with the job, as replayed jobs are not kept for the whole simulation
+        auto indices = std::make_shared<std::vector<uint32_t>>();
+        indices->reserve(record.infiles.size());
+        for (auto const &name: record.infiles) {
+            size_t f;
+            if (!this->files->findFile(name, f) && !this->mapLFN(name, f)) {
+                throw std::runtime_error("Input-file " + name + " of job " + record.jobid + " in job trace " + this->path +
+                                         " is not part of any infile dataset of the workload and no trace_lfn_dataset is configured");
+            }
+            indices->push_back(static_cast<uint32_t>(f));
+        }
+        job_specification.infiles = FileRange(this->files, std::move(indices));
+    }
+    WRENCH_DEBUG("Replaying job %s submitted at %f", job_specification.jobid.c_str(), record.submit_time);
+    return job_specification;
+}
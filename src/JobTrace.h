@@ -0,0 +1,130 @@
+
+
+#ifndef S_JOBTRACE_H
+#define S_JOBTRACE_H
+
+#include <cfloat>
+#include <fstream>
+#include <queue>
+#include <unordered_map>
+
+#include <wrench-dev.h>
+
+#include "JobSpecification.h"
+#include "Dataset.h"
+
+/**
+ * @brief A job as recorded in a job trace
+ */
+struct TraceRecord {
+    // identifier of the job in the trace
+    std::string jobid;
+    // submission time as recorded in the trace
+    double submit_time = 0.;
+    // number of cores requested
+    int cores = 1;
+    // total number of FLOPS computed
+    double flops = 0.;
+    // memory consumption
+    sg_size_t memory = 0;
+    // size of the output file written
+    sg_size_t outfile_size = 0;
+    // names of the input files read
+    std::vector<std::string> infiles;
+};
+
+/**
+ * @brief Reader replaying the jobs of a job trace (e.g. an HTCondor job history) from a CSV or binary file.
+ * Jobs are streamed in submission-time order through a reorder buffer of bounded size,
+ * so that only a window of the trace is held in memory at any time.
+ */
+class JobTrace {
+
+public:
+    JobTrace(const std::string &path, size_t lookahead, double core_speed, const std::string &lfn_dataset = "");
+
+    void mapFiles(FileList all_files);
+
+    bool hasNext();
+
+    double peekSubmitTime();
+
+    JobSpecification next(const std::string &name_suffix);
+
+    const std::string &getPath() const {
+        return this->path;
+    }
+
+    size_t getLookahead() const {
+        return this->lookahead;
+    }
+
+    double getCoreSpeed() const {
+        return this->core_speed;
+    }
+
+    const std::string &getLFNDataset() const {
+        return this->lfn_dataset;
+    }
+
+    /** @brief magic number at the start of binary traces */
+    static constexpr char magic[8] = {'D', 'C', 'S', 'T', 'R', 'A', 'C', 'E'};
+    /** @brief version of the binary trace format */
+    static constexpr uint32_t version = 1;
+
+private:
+    bool readRecord(TraceRecord &record);
+    bool readCSVRecord(TraceRecord &record);
+    bool readBinaryRecord(TraceRecord &record);
+    void parseCSVHeader(const std::string &line);
+    void fillBuffer();
+    bool mapLFN(const std::string &name, size_t &i);
+
+    std::string path;
+    std::ifstream in;
+    bool binary = false;
+    bool exhausted = false;
+    size_t line_number = 0;
+    size_t num_read = 0;
+    // jobs replayed so far, which index the output-files of the replayed jobs
+    size_t num_replayed = 0;
+
+    // column of each field in CSV traces
+    std::unordered_map<std::string, size_t> columns;
+
+    /** @brief maximal number of jobs buffered ahead to restore submission-time order **/
+    size_t lookahead;
+    /** @brief FLOPS per second of CPU time, converting CPU times into FLOPS **/
+    double core_speed;
+    /** @brief dataset whose files the input-files unknown by name are assigned to on first sight, none if empty **/
+    std::string lfn_dataset;
+
+    // jobs read ahead, ordered by submission time and by position in the trace on ties
+    struct BufferedRecord {
+        TraceRecord record;
+        size_t position;
+        bool operator>(const BufferedRecord &other) const {
+            return record.submit_time > other.record.submit_time ||
+                   (record.submit_time == other.record.submit_time && position > other.position);
+        }
+    };
+    std::priority_queue<BufferedRecord, std::vector<BufferedRecord>, std::greater<>> buffer;
+
+    // submission time of the first job, to which all submission times are relative
+    double first_submit_time = 0.;
+    // submission time of the job replayed last
+    double last_submit_time = -DBL_MAX;
+
+    // whether input-files are resolved, which they are not for calculation workloads
+    bool resolve_files = false;
+    // files of the infile datasets, which the input views of replayed jobs point into
+    const FileList *files = nullptr;
+    // files of the LFN dataset in the file list and the next one not assigned to any LFN yet
+    size_t lfn_offset = 0;
+    size_t lfn_count = 0;
+    size_t next_lfn = 0;
+    // index in the file list of each LFN assigned so far
+    std::unordered_map<std::string, uint32_t> lfn_indices;
+};
+
+#endif//S_JOBTRACE_H
@@ -1,44 +1,88 @@
 #ifndef S_LRU_FILELIST_H
 #define S_LRU_FILELIST_H
 
+#include <functional>
 #include <memory>
+#include <set>
+#include <tuple>
+#include <unordered_map>
 
 #include <wrench-dev.h>
 
+#include "util/Utils.h"
+
+/**
+ * @brief Collection of the files on a storage, ordered by the sequence in which they
+ * are evicted. The order follows the LRU scheme by default, other eviction policies can be set.
+ */
 class LRU_FileList {
 
 public:
+    /**
+     * @brief Set the eviction policy, which must happen before any file is added
+     *
+     * @param policy
+     */
+    void setEvictionPolicy(EvictionPolicy policy) {
+        if (!this->indexed_files.empty()) {
+            throw std::runtime_error("The eviction policy of a non-empty file list cannot be changed!");
+        }
+        this->eviction_policy = policy;
+    }
+
     /**
      * @brief Touch a file to update its last access time
-     * 
-     * @param file 
+     *
+     * @param file
      */
     void touchFile(wrench::DataFile *file) {
+        this->sequence++;
+        auto indexed_file = this->indexed_files.find(file);
         // If the file is new, then it's easy
-        if (this->indexed_files.find(file) == this->indexed_files.end()) {
-            this->indexed_files[file] = 0;
-            this->lru_list.insert(this->lru_list.begin(), file);
+        if (indexed_file == this->indexed_files.end()) {
+            Entry entry{this->evictionPriority(file, 1), this->sequence, file};
+            this->eviction_order.insert(entry);
+            this->indexed_files[file] = std::make_pair(entry, 1);
+            this->total_size += file->getSize();
             return;
         }
 
-        // if the file is not new, then we need to do a bit of work
-        auto current_index = indexed_files[file];
-        this->lru_list.erase(this->lru_list.begin() + current_index);
-        this->indexed_files[file] = 0;
-        this->lru_list.insert(this->lru_list.begin(), file);
+        // if the file is not new, then it has to be moved in the eviction order
+        auto &[entry, accesses] = indexed_file->second;
+        accesses++;
+        if (this->eviction_policy == EvictionPolicy::FIFOEviction) return;
+        this->eviction_order.erase(entry);
+        entry = Entry{this->evictionPriority(file, accesses), this->sequence, file};
+        this->eviction_order.insert(entry);
     }
 
     /**
-     * @brief Identify the file touched last from file collection, 
-     * which shall be evicted according to LRU policy
-     * 
-     * @return std::shared_ptr<wrench::DataFile> 
+     * @brief Identify the file to be evicted next according to the eviction policy
+     * from file collection and remove it
+     *
+     * @return std::shared_ptr<wrench::DataFile>
      */
     std::shared_ptr<wrench::DataFile> removeLRUFile() {
-        auto file = this->lru_list.back();
-        this->lru_list.pop_back();
-        this->indexed_files.erase(file);
-        return wrench::Simulation::getFileByID(file->getID());
+        return this->removeLRUFile([](wrench::DataFile *) { return false; });
+    }
+
+    /**
+     * @brief Identify the file to be evicted next according to the eviction policy
+     * among the files which may be evicted and remove it
+     *
+     * @param keep Predicate telling which files must not be evicted
+     * @return std::shared_ptr<wrench::DataFile>, nullptr if all files must be kept
+     */
+    std::shared_ptr<wrench::DataFile> removeLRUFile(const std::function<bool(wrench::DataFile *)> &keep) {
+        for (auto it = this->eviction_order.begin(); it != this->eviction_order.end(); ++it) {
+            auto file = std::get<2>(*it);
+            if (keep(file)) continue;
+            this->eviction_order.erase(it);
+            this->indexed_files.erase(file);
+            this->total_size -= file->getSize();
+            return wrench::Simulation::getFileByID(file->getID());
+        }
+        return nullptr;
     }
 
     /**
@@ -50,12 +94,52 @@ public:
         return (this->indexed_files.find(file.get()) != this->indexed_files.end());
     }
 
+    /**
+     * @brief Number of files in the list
+     * @return the number of files
+     */
+    size_t getNumFiles() const {
+        return this->indexed_files.size();
+    }
+
+    /**
+     * @brief Incremental size of all files in the list
+     * @return the occupied space in bytes
+     */
+    sg_size_t getTotalSize() const {
+        return this->total_size;
+    }
+
 
 private:
-    // File collection mapped to index
-    std::map<wrench::DataFile *, ssize_t> indexed_files;
-    // Ordered list of files in file collection -- front is most recently used.
-    std::vector<wrench::DataFile *> lru_list;
+    // Position in the eviction order: priority, access sequence number breaking ties, file
+    typedef std::tuple<double, unsigned long long, wrench::DataFile *> Entry;
+
+    /**
+     * @brief Priority of a file in the eviction order, files with lowest priority are evicted first
+     */
+    double evictionPriority(wrench::DataFile *file, unsigned long long accesses) const {
+        switch (this->eviction_policy) {
+            case EvictionPolicy::LFUEviction:
+                return static_cast<double>(accesses);
+            case EvictionPolicy::LargestFirstEviction:
+                return -static_cast<double>(file->getSize());
+            case EvictionPolicy::LRUEviction:
+            case EvictionPolicy::FIFOEviction:
+            default:
+                return 0.;
+        }
+    }
+
+    EvictionPolicy eviction_policy = EvictionPolicy::LRUEviction;
+    // File collection mapped to its position in the eviction order and number of accesses
+    std::unordered_map<wrench::DataFile *, std::pair<Entry, unsigned long long>> indexed_files;
+    // Ordered collection of files -- front is evicted first
+    std::set<Entry> eviction_order;
+    // Counter of file accesses
+    unsigned long long sequence = 0;
+    // Incremental size of all files in the collection
+    sg_size_t total_size = 0;
 };
 
 #endif//S_LRU_FILELIST_H
@@ -0,0 +1,130 @@
+#include <wrench-dev.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(output_uploader, "Log category for OutputUploader");
+
+#include "OutputUploader.h"
+#include "SimpleSimulator.h"
+#include "computation/AsyncRead.h"
+#include "monitoring/NetworkMonitor.h"
+
+
+std::map<std::string, std::unique_ptr<OutputUploader>> OutputUploader::uploaders;
+size_t OutputUploader::num_pending = 0;
+simgrid::s4u::MutexPtr OutputUploader::pending_mutex;
+simgrid::s4u::ConditionVariablePtr OutputUploader::all_uploaded;
+
+
+/**
+ * @brief Construct a new OutputUploader object and start its worker actors on the given host.
+ * The actors are daemons, which don't keep the simulation alive.
+ *
+ * @param site Network zone the agent uploads the staged outputs of
+ * @param hostname Host the worker actors run on
+ */
+OutputUploader::OutputUploader(const std::string &site, const std::string &hostname) : site(site) {
+    this->mutex = simgrid::s4u::Mutex::create();
+    this->not_empty = simgrid::s4u::ConditionVariable::create();
+    auto host = simgrid::s4u::Host::by_name(hostname);
+    for (unsigned int w = 0; w < SimpleSimulator::stage_out_uploads; w++) {
+        simgrid::s4u::Actor::create("output_uploader_" + site + "_" + std::to_string(w), host, [this]() { this->run(); })->daemonize();
+    }
+}
+
+/**
+ * @brief Upload agent of the site a staging storage belongs to, created on first use
+ *
+ * @param staging Cache storage service outputs are staged out onto
+ * @return the agent
+ */
+OutputUploader &OutputUploader::get(const std::shared_ptr<wrench::StorageService> &staging) {
+    if (!OutputUploader::pending_mutex) {
+        OutputUploader::pending_mutex = simgrid::s4u::Mutex::create();
+        OutputUploader::all_uploaded = simgrid::s4u::ConditionVariable::create();
+    }
+    std::string site = simgrid::s4u::Host::by_name(staging->getHostname())->get_englobing_zone()->get_name();
+    auto &uploader = OutputUploader::uploaders[site];
+    if (!uploader) {
+        uploader = std::make_unique<OutputUploader>(site, staging->getHostname());
+    }
+    return *uploader;
+}
+
+/**
+ * @brief Hand a staged output-file over to the upload agent of its site without blocking
+ *
+ * @param staging Cache storage service the file was staged out onto
+ * @param file Output-file
+ * @param destination GRID storage service to upload the file to
+ * @param uploaded Called by the agent once the file is on its destination
+ */
+void OutputUploader::upload(const std::shared_ptr<wrench::StorageService> &staging,
+                            const std::shared_ptr<wrench::DataFile> &file,
+                            const std::shared_ptr<wrench::StorageService> &destination,
+                            std::function<void()> uploaded) {
+    auto &uploader = OutputUploader::get(staging);
+    {
+        std::unique_lock<simgrid::s4u::Mutex> lock(*OutputUploader::pending_mutex);
+        OutputUploader::num_pending++;
+    }
+    std::unique_lock<simgrid::s4u::Mutex> lock(*uploader.mutex);
+    uploader.queue.push_back(Request{staging, file, destination, std::move(uploaded)});
+    uploader.not_empty->notify_one();
+}
+
+/**
+ * @brief Block the calling actor until all uploads handed over so far have completed,
+ * as the daemonized agents stop with the last non-daemon actor
+ */
+void OutputUploader::waitForUploads() {
+    if (!OutputUploader::pending_mutex) return;
+    std::unique_lock<simgrid::s4u::Mutex> lock(*OutputUploader::pending_mutex);
+    while (OutputUploader::num_pending > 0) {
+        OutputUploader::all_uploaded->wait(lock);
+    }
+}
+
+/**
+ * @brief Main loop of a worker actor, uploading the queued outputs in order.
+ * A file is read from the staging cache's disk, sent to the destination's host and written onto its disk.
+ * The workers are plain SimGrid actors, which can't talk to WRENCH storage services, so uploads bypass
+ * the buffered transfers of the storage services that direct writes of output-files go through.
+ */
+void OutputUploader::run() {
+    while (true) {
+        std::unique_lock<simgrid::s4u::Mutex> lock(*this->mutex);
+        while (this->queue.empty()) {
+            this->not_empty->wait(lock);
+        }
+        Request request = std::move(this->queue.front());
+        this->queue.pop_front();
+        lock.unlock();
+
+        // The upload is accounted for as completed even if it fails, lest the controllers wait for it for ever
+        try {
+            WRENCH_DEBUG("Uploading file %s from %s to %s", request.file->getID().c_str(),
+                         request.staging->getHostname().c_str(), request.destination->getHostname().c_str());
+            auto num_bytes = request.file->getSize();
+            auto source = simgrid::s4u::Host::by_name(request.staging->getHostname());
+            auto destination = simgrid::s4u::Host::by_name(request.destination->getHostname());
+            double read_start = wrench::Simulation::getCurrentSimulatedDate();
+            AsyncRead::getStorageDisk(request.staging->getHostname())->read(num_bytes);
+            NetworkMonitor::recordRead(request.staging, num_bytes, read_start);
+            if (source != destination) {
+                simgrid::s4u::Comm::sendto(source, destination, num_bytes);
+            }
+            double write_start = wrench::Simulation::getCurrentSimulatedDate();
+            AsyncRead::getStorageDisk(request.destination->getHostname())->write(num_bytes);
+            NetworkMonitor::recordWrite(request.destination, num_bytes, write_start);
+            wrench::StorageService::createFileAtLocation(wrench::FileLocation::LOCATION(request.destination, request.file));
+            request.uploaded();
+        } catch (std::exception &e) {
+            WRENCH_INFO("Upload of file %s to %s failed: %s", request.file->getID().c_str(),
+                        request.destination->getHostname().c_str(), e.what());
+        }
+
+        std::unique_lock<simgrid::s4u::Mutex> pending_lock(*OutputUploader::pending_mutex);
+        if (--OutputUploader::num_pending == 0) {
+            OutputUploader::all_uploaded->notify_all();
+        }
+    }
+}
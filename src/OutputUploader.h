@@ -0,0 +1,56 @@
+
+
+#ifndef S_OUTPUTUPLOADER_H
+#define S_OUTPUTUPLOADER_H
+
+#include <deque>
+#include <functional>
+
+#include <wrench-dev.h>
+
+/**
+ * @brief Upload agent of a site, which transfers the output-files jobs staged out onto the site's caches
+ * to their GRID storages in the background, so that jobs release their cores as soon as their outputs
+ * are written locally. Each agent runs SimpleSimulator::stage_out_uploads worker actors.
+ */
+class OutputUploader {
+
+public:
+    OutputUploader(const std::string &site, const std::string &hostname);
+
+    static void upload(const std::shared_ptr<wrench::StorageService> &staging,
+                       const std::shared_ptr<wrench::DataFile> &file,
+                       const std::shared_ptr<wrench::StorageService> &destination,
+                       std::function<void()> uploaded);
+    static void waitForUploads();
+
+private:
+    /**
+     * @brief Output-file staged out and waiting for its upload
+     */
+    struct Request {
+        std::shared_ptr<wrench::StorageService> staging;
+        std::shared_ptr<wrench::DataFile> file;
+        std::shared_ptr<wrench::StorageService> destination;
+        // called once the file is on its destination
+        std::function<void()> uploaded;
+    };
+
+    static OutputUploader &get(const std::shared_ptr<wrench::StorageService> &staging);
+
+    void run();
+
+    std::string site;
+    std::deque<Request> queue;
+    simgrid::s4u::MutexPtr mutex;
+    simgrid::s4u::ConditionVariablePtr not_empty;
+
+    static std::map<std::string, std::unique_ptr<OutputUploader>> uploaders;
+
+    // uploads handed over to any agent and not yet completed
+    static size_t num_pending;
+    static simgrid::s4u::MutexPtr pending_mutex;
+    static simgrid::s4u::ConditionVariablePtr all_uploaded;
+};
+
+#endif//S_OUTPUTUPLOADER_H
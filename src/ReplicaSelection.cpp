@@ -0,0 +1,157 @@
+#include <wrench-dev.h>
+
+#include "ReplicaSelection.h"
+#include "SimpleSimulator.h"
+#include "computation/AsyncRead.h"
+
+#include <cmath>
+
+
+std::map<std::pair<std::string, wrench::StorageService *>, ReplicaSelection::RouteInfo> ReplicaSelection::routes;
+std::map<std::pair<std::string, wrench::StorageService *>, ReplicaSelection::ObservedThroughput> ReplicaSelection::throughputs;
+std::map<std::string, size_t> ReplicaSelection::round_robin_counters;
+
+
+/**
+ * @brief Pick the storage service to read a file from
+ *
+ * @param policy Replica selection policy
+ * @param replicas Storage services holding the file, must not be empty
+ * @param hostname Host the file is read to
+ * @param file File to read
+ * @return the chosen storage service
+ */
+std::shared_ptr<wrench::StorageService> ReplicaSelection::pick(const ReplicaSelectionPolicy policy,
+                                                               const std::vector<std::shared_ptr<wrench::StorageService>> &replicas,
+                                                               const std::string &hostname,
+                                                               const std::shared_ptr<wrench::DataFile> &file) {
+    if (replicas.size() == 1) return replicas.front();
+
+    switch (policy) {
+        case ReplicaSelectionPolicy::BandwidthReplica: {
+            // Shortest estimated transfer time along the route
+            std::shared_ptr<wrench::StorageService> chosen;
+            double min_transfer_time = std::numeric_limits<double>::max();
+            for (auto const &replica: replicas) {
+                auto const &route = ReplicaSelection::getRoute(hostname, replica);
+                double transfer_time = route.latency + static_cast<double>(file->getSize()) / route.bandwidth;
+                if (transfer_time < min_transfer_time) {
+                    chosen = replica;
+                    min_transfer_time = transfer_time;
+                }
+            }
+            return chosen;
+        }
+        case ReplicaSelectionPolicy::ThroughputReplica: {
+            // Highest observed throughput, unobserved replicas are optimistically rated with their route bandwidth
+            std::shared_ptr<wrench::StorageService> chosen;
+            double max_throughput = -1.;
+            for (auto const &replica: replicas) {
+                double throughput = ReplicaSelection::getThroughput(hostname, replica);
+                if (throughput > max_throughput) {
+                    chosen = replica;
+                    max_throughput = throughput;
+                }
+            }
+            return chosen;
+        }
+        case ReplicaSelectionPolicy::RoundRobinReplica: {
+            // Cycle per network zone through the replicas, ordered by hostname to be independent of memory layout
+            auto zone = simgrid::s4u::Host::by_name(hostname)->get_englobing_zone()->get_name();
+            auto ordered = replicas;
+            std::sort(ordered.begin(), ordered.end(), [](const std::shared_ptr<wrench::StorageService> &a, const std::shared_ptr<wrench::StorageService> &b) {
+                return a->getHostname() < b->getHostname();
+            });
+            return ordered.at(ReplicaSelection::round_robin_counters[zone]++ % ordered.size());
+        }
+        case ReplicaSelectionPolicy::WeightedReplica: {
+            std::vector<double> weights;
+            for (auto const &replica: replicas) {
+                weights.push_back(ReplicaSelection::getServingCapacity(replica));
+            }
+            std::discrete_distribution<size_t> pick_replica(weights.begin(), weights.end());
+            return replicas.at(pick_replica(SimpleSimulator::gen));
+        }
+        case ReplicaSelectionPolicy::FirstReplica:
+        default:
+            return replicas.front();
+    }
+}
+
+/**
+ * @brief Update the exponentially decaying average of the throughput observed
+ * when reading from a storage service into a network zone
+ *
+ * @param hostname Host the data was read to
+ * @param storage_service Storage service read from
+ * @param num_bytes Number of bytes read
+ * @param duration Duration of the read
+ */
+void ReplicaSelection::recordThroughput(const std::string &hostname, const std::shared_ptr<wrench::StorageService> &storage_service,
+                                        const sg_size_t num_bytes, const double duration) {
+    if (duration <= 0.) return;
+    double throughput = static_cast<double>(num_bytes) / duration;
+    auto key = std::make_pair(simgrid::s4u::Host::by_name(hostname)->get_englobing_zone()->get_name(), storage_service.get());
+    auto average = ReplicaSelection::throughputs.find(key);
+    if (average == ReplicaSelection::throughputs.end()) {
+        ReplicaSelection::throughputs[key] = ObservedThroughput{throughput, wrench::Simulation::getCurrentSimulatedDate()};
+    } else {
+        double previous = ReplicaSelection::getThroughput(hostname, storage_service);
+        average->second = ObservedThroughput{ReplicaSelection::throughput_decay * throughput + (1. - ReplicaSelection::throughput_decay) * previous,
+                                             wrench::Simulation::getCurrentSimulatedDate()};
+    }
+}
+
+/**
+ * @brief Throughput a storage service is rated with for reading into a host's network zone.
+ * The observed average relaxes towards the route bandwidth while no reads are observed,
+ * so that a storage rated down by a few slow reads gets explored again.
+ *
+ * @param hostname Host the data is read to
+ * @param storage_service Storage service read from
+ * @return the rated throughput in bytes per second
+ */
+double ReplicaSelection::getThroughput(const std::string &hostname, const std::shared_ptr<wrench::StorageService> &storage_service) {
+    double prior = ReplicaSelection::getRoute(hostname, storage_service).bandwidth;
+    auto key = std::make_pair(simgrid::s4u::Host::by_name(hostname)->get_englobing_zone()->get_name(), storage_service.get());
+    auto observed = ReplicaSelection::throughputs.find(key);
+    if (observed == ReplicaSelection::throughputs.end()) return prior;
+    double age = wrench::Simulation::getCurrentSimulatedDate() - observed->second.time;
+    double weight = std::exp(-age / ReplicaSelection::throughput_memory);
+    return weight * observed->second.average + (1. - weight) * prior;
+}
+
+/**
+ * @brief Bottleneck bandwidth and latency of the route from a storage service to a host,
+ * memoized for the host's network zone
+ *
+ * @param hostname Host the data is read to
+ * @param storage_service Storage service read from
+ * @return the route properties
+ */
+const ReplicaSelection::RouteInfo &ReplicaSelection::getRoute(const std::string &hostname, const std::shared_ptr<wrench::StorageService> &storage_service) {
+    auto host = simgrid::s4u::Host::by_name(hostname);
+    auto key = std::make_pair(host->get_englobing_zone()->get_name(), storage_service.get());
+    auto route = ReplicaSelection::routes.find(key);
+    if (route != ReplicaSelection::routes.end()) return route->second;
+
+    std::vector<simgrid::s4u::Link *> links;
+    double latency = 0.;
+    simgrid::s4u::Host::by_name(storage_service->getHostname())->route_to(host, links, &latency);
+    double bandwidth = std::numeric_limits<double>::max();
+    for (auto const &link: links) {
+        bandwidth = std::min(bandwidth, link->get_bandwidth());
+    }
+    return ReplicaSelection::routes[key] = RouteInfo{bandwidth, latency};
+}
+
+/**
+ * @brief Rate at which a storage service can serve data, given by the read bandwidth of its disk
+ *
+ * @param storage_service
+ * @return the read bandwidth in bytes per second
+ */
+double ReplicaSelection::getServingCapacity(const std::shared_ptr<wrench::StorageService> &storage_service) {
+    auto disk = AsyncRead::getStorageDisk(storage_service->getHostname());
+    return disk ? disk->get_read_bandwidth() : 1.;
+}
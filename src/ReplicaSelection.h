@@ -0,0 +1,60 @@
+
+
+#ifndef S_REPLICASELECTION_H
+#define S_REPLICASELECTION_H
+
+#include <wrench-dev.h>
+
+#include "util/Utils.h"
+
+/**
+ * @brief Selection of the GRID storage service a file not found in any cache is read from.
+ * Route properties and observed throughputs are memoized per pair of network zone and storage service.
+ */
+class ReplicaSelection {
+
+public:
+    static std::shared_ptr<wrench::StorageService> pick(ReplicaSelectionPolicy policy,
+                                                        const std::vector<std::shared_ptr<wrench::StorageService>> &replicas,
+                                                        const std::string &hostname,
+                                                        const std::shared_ptr<wrench::DataFile> &file);
+
+    static void recordThroughput(const std::string &hostname, const std::shared_ptr<wrench::StorageService> &storage_service,
+                                 sg_size_t num_bytes, double duration);
+
+    /** @brief Weight of a new observation in the exponentially decaying throughput average */
+    static constexpr double throughput_decay = 0.2;
+    /** @brief Simulated seconds without observations after which the throughput average has mostly relaxed to the route bandwidth */
+    static constexpr double throughput_memory = 600.;
+
+private:
+    /**
+     * @brief Properties of the route between a network zone and a storage service
+     */
+    struct RouteInfo {
+        // bandwidth of the bottleneck link in bytes per second
+        double bandwidth;
+        // accumulated latency in seconds
+        double latency;
+    };
+
+    /**
+     * @brief Exponentially decaying average of the throughput observed between a network zone and a storage service
+     */
+    struct ObservedThroughput {
+        // average throughput in bytes per second
+        double average;
+        // simulated time of the last observation
+        double time;
+    };
+
+    static const RouteInfo &getRoute(const std::string &hostname, const std::shared_ptr<wrench::StorageService> &storage_service);
+    static double getServingCapacity(const std::shared_ptr<wrench::StorageService> &storage_service);
+    static double getThroughput(const std::string &hostname, const std::shared_ptr<wrench::StorageService> &storage_service);
+
+    static std::map<std::pair<std::string, wrench::StorageService *>, RouteInfo> routes;
+    static std::map<std::pair<std::string, wrench::StorageService *>, ObservedThroughput> throughputs;
+    static std::map<std::string, size_t> round_robin_counters;
+};
+
+#endif//S_REPLICASELECTION_H
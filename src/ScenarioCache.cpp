@@ -0,0 +1,485 @@
+#include "ScenarioCache.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(scenario_cache, "Log category for ScenarioCache");
+
+
+constexpr char ScenarioCache::magic[8];
+constexpr uint32_t ScenarioCache::version;
+
+static_assert(sizeof(sg_size_t) == 8, "sg_size_t is stored as 64-bit number");
+
+namespace {
+
+    /** @brief marker written in the byte order of the writing host */
+    constexpr uint32_t byte_order = 0x01020304;
+
+    /**
+     * @brief Fixed-size header of a scenario cache
+     */
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t key;
+        uint64_t num_datasets;
+        uint64_t num_workloads;
+    };
+
+    /**
+     * @brief Sequential writer padding every item to 8 bytes
+     */
+    class Writer {
+    public:
+        explicit Writer(std::ofstream &out) : out(out) {}
+
+        void bytes(const void *data, size_t size) {
+            static const char padding[8] = {};
+            this->out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+            this->out.write(padding, static_cast<std::streamsize>((8 - size % 8) % 8));
+        }
+
+        void u64(uint64_t value) { this->bytes(&value, sizeof(value)); }
+
+        void f64(double value) { this->bytes(&value, sizeof(value)); }
+
+        void str(const std::string &s) {
+            this->u64(s.size());
+            this->bytes(s.data(), s.size());
+        }
+
+        template<typename T>
+        void array(const std::vector<T> &values) {
+            this->u64(values.size());
+            this->bytes(values.data(), values.size() * sizeof(T));
+        }
+
+    private:
+        std::ofstream &out;
+    };
+
+    /**
+     * @brief Sequential reader of a mapped scenario cache, returning arrays in place,
+     * which stay valid as long as the mapping
+     */
+    class Reader {
+    public:
+        Reader(const char *begin, const char *end) : pos(begin), end(end) {}
+
+        const char *bytes(size_t size) {
+            size_t padded = size + (8 - size % 8) % 8;
+            if (padded < size || static_cast<size_t>(this->end - this->pos) < padded) {
+                throw std::runtime_error("scenario cache is truncated");
+            }
+            const char *data = this->pos;
+            this->pos += padded;
+            return data;
+        }
+
+        uint64_t u64() {
+            uint64_t value;
+            std::memcpy(&value, this->bytes(sizeof(value)), sizeof(value));
+            return value;
+        }
+
+        double f64() {
+            double value;
+            std::memcpy(&value, this->bytes(sizeof(value)), sizeof(value));
+            return value;
+        }
+
+        std::string str() {
+            uint64_t size = this->u64();
+            return {this->bytes(size), size};
+        }
+
+        template<typename T>
+        const T *array(uint64_t &size) {
+            size = this->u64();
+            if (size > static_cast<uint64_t>(this->end - this->pos) / sizeof(T)) {
+                throw std::runtime_error("scenario cache is truncated");
+            }
+            return reinterpret_cast<const T *>(this->bytes(size * sizeof(T)));
+        }
+
+    private:
+        const char *pos;
+        const char *end;
+    };
+
+    /**
+     * @brief A dataset as read from the mapping
+     */
+    struct CachedDataset {
+        std::string name;
+        std::vector<std::string> hostnames;
+        const sg_size_t *file_sizes;
+        uint64_t num_files;
+    };
+
+    /**
+     * @brief A workload as read from the mapping
+     */
+    struct CachedWorkload {
+        std::string name;
+        WorkloadType workload_type;
+        double arrival_time;
+        std::vector<std::string> infile_datasets;
+        std::vector<std::string> upstream_workloads;
+        std::string output_storage;
+        std::string cpu_scaling;
+        bool is_trace;
+        // replayed workloads
+        std::string trace_path;
+        uint64_t trace_lookahead;
+        double core_speed;
+        std::string lfn_dataset;
+        // sampled workloads
+        uint64_t num_jobs;
+        const int32_t *cores;
+        const double *flops;
+        const sg_size_t *memory;
+        const sg_size_t *outfile_sizes;
+        const uint64_t *infile_offsets;
+        const uint64_t *infiles;
+        uint64_t num_infiles;
+    };
+
+    /**
+     * @brief Read-only mapping of a file, unmapped on destruction
+     */
+    struct Mapping {
+        const char *data = nullptr;
+        size_t size = 0;
+
+        ~Mapping() {
+            if (this->data) {
+                munmap(const_cast<char *>(this->data), this->size);
+            }
+        }
+    };
+
+    std::vector<std::string> readStrings(Reader &reader) {
+        std::vector<std::string> strings(reader.u64());
+        for (auto &s: strings) {
+            s = reader.str();
+        }
+        return strings;
+    }
+
+    void writeStrings(Writer &writer, const std::vector<std::string> &strings) {
+        writer.u64(strings.size());
+        for (auto const &s: strings) {
+            writer.str(s);
+        }
+    }
+}// namespace
+
+
+/**
+ * @brief Key identifying a scenario by the contents of its configuration files and the seed
+ *
+ * @param seed Seed the files and jobs are sampled with
+ * @param dataset_configurations Paths of the dataset configuration files
+ * @param workload_configurations Paths of the workload configuration files
+ * @return 64-bit FNV-1a hash
+ */
+uint64_t ScenarioCache::key(const unsigned int seed,
+                            const std::vector<std::string> &dataset_configurations,
+                            const std::vector<std::string> &workload_configurations) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const void *data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= static_cast<const unsigned char *>(data)[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    add(&ScenarioCache::version, sizeof(ScenarioCache::version));
+    add(&seed, sizeof(seed));
+    for (auto const *configurations: {&dataset_configurations, &workload_configurations}) {
+        uint64_t num_configurations = configurations->size();
+        add(&num_configurations, sizeof(num_configurations));
+        for (auto const &path: *configurations) {
+            std::ifstream conf(path, std::ios::in | std::ios::binary);
+            std::string contents((std::istreambuf_iterator<char>(conf)), std::istreambuf_iterator<char>());
+            uint64_t size = contents.size();
+            add(&size, sizeof(size));
+            add(contents.data(), contents.size());
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Map a scenario cache and create its datasets and workloads
+ *
+ * @param path Path of the scenario cache
+ * @param key Key of the scenario to be simulated
+ * @param datasets Datasets created
+ * @param workloads Workloads created
+ * @return true if the datasets and workloads were created from the cache,
+ * false if there is no valid cache for the scenario, in which case nothing was created
+ *
+ * @throw std::runtime_error if a replayed job trace can not be opened
+ */
+bool ScenarioCache::load(const std::string &path, const uint64_t key,
+                         std::vector<Dataset> &datasets, std::vector<Workload> &workloads) {
+    Mapping mapping;
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        std::cerr << "WARNING: Ignoring invalid scenario cache " << path << std::endl;
+        return false;
+    }
+    void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        std::cerr << "WARNING: Could not map scenario cache " << path << std::endl;
+        return false;
+    }
+    mapping.data = static_cast<const char *>(data);
+    mapping.size = static_cast<size_t>(st.st_size);
+
+    // Validate the whole cache before anything is registered with the simulation
+    std::vector<CachedDataset> cached_datasets;
+    std::vector<CachedWorkload> cached_workloads;
+    uint64_t num_files = 0;
+    try {
+        Reader reader(mapping.data, mapping.data + mapping.size);
+        Header header{};
+        std::memcpy(&header, reader.bytes(sizeof(Header)), sizeof(Header));
+        if (std::memcmp(header.magic, ScenarioCache::magic, sizeof(header.magic)) != 0 ||
+            header.version != ScenarioCache::version || header.byte_order != byte_order) {
+            std::cerr << "WARNING: Ignoring scenario cache " << path << " of a different version" << std::endl;
+            return false;
+        }
+        if (header.key != key) {
+            std::cerr << "Scenario cache " << path << " holds a different scenario, resampling" << std::endl;
+            return false;
+        }
+
+        cached_datasets.resize(header.num_datasets);
+        for (auto &ds: cached_datasets) {
+            ds.name = reader.str();
+            ds.hostnames = readStrings(reader);
+            ds.file_sizes = reader.array<sg_size_t>(ds.num_files);
+            num_files += ds.num_files;
+        }
+
+        cached_workloads.resize(header.num_workloads);
+        for (auto &ws: cached_workloads) {
+            ws.name = reader.str();
+            uint64_t workload_type = reader.u64();
+            if (workload_type >= WorkloadType::NumWorkloadTypes) {
+                throw std::runtime_error("invalid workload type");
+            }
+            ws.workload_type = static_cast<WorkloadType>(workload_type);
+            ws.arrival_time = reader.f64();
+            ws.infile_datasets = readStrings(reader);
+            ws.upstream_workloads = readStrings(reader);
+            ws.output_storage = reader.str();
+            ws.cpu_scaling = reader.str();
+            ws.is_trace = reader.u64() != 0;
+            if (ws.is_trace) {
+                ws.trace_path = reader.str();
+                ws.trace_lookahead = reader.u64();
+                ws.core_speed = reader.f64();
+                ws.lfn_dataset = reader.str();
+                continue;
+            }
+            uint64_t size;
+            ws.cores = reader.array<int32_t>(ws.num_jobs);
+            ws.flops = reader.array<double>(size);
+            bool consistent = size == ws.num_jobs;
+            ws.memory = reader.array<sg_size_t>(size);
+            consistent &= size == ws.num_jobs;
+            ws.outfile_sizes = reader.array<sg_size_t>(size);
+            consistent &= size == ws.num_jobs;
+            ws.infile_offsets = reader.array<uint64_t>(size);
+            consistent &= size == ws.num_jobs + 1;
+            ws.infiles = reader.array<uint64_t>(ws.num_infiles);
+            if (!consistent || ws.infile_offsets[ws.num_jobs] != ws.num_infiles) {
+                throw std::runtime_error("inconsistent job arrays");
+            }
+            for (uint64_t j = 0; j < ws.num_jobs; j++) {
+                if (ws.infile_offsets[j] > ws.infile_offsets[j + 1]) {
+                    throw std::runtime_error("inconsistent input-file offsets");
+                }
+            }
+            // the output-files of sampled workloads follow the files of the datasets
+            num_files += ws.num_jobs;
+        }
+        for (auto const &ws: cached_workloads) {
+            for (uint64_t i = 0; !ws.is_trace && i < ws.num_infiles; i++) {
+                if (ws.infiles[i] >= num_files) {
+                    throw std::runtime_error("input-file out of range");
+                }
+            }
+        }
+    } catch (std::runtime_error &e) {
+        std::cerr << "WARNING: Ignoring corrupted scenario cache " << path << " (" << e.what() << ")" << std::endl;
+        return false;
+    }
+
+    // Create the datasets and workloads, copying the arrays out of the mapping, which is released on return
+    FileList all_files;
+    for (auto const &ds: cached_datasets) {
+        datasets.emplace_back(ds.hostnames, ds.file_sizes, ds.num_files, ds.name);
+        all_files.addDataset(datasets.back().files.get());
+    }
+    for (auto const &ws: cached_workloads) {
+        if (ws.is_trace) {
+            workloads.emplace_back(ws.trace_path, ws.trace_lookahead, ws.core_speed, ws.lfn_dataset,
+                                   ws.workload_type, ws.name, ws.arrival_time, ws.infile_datasets);
+        } else {
+            std::vector<JobSpecification> jobs(ws.num_jobs);
+            for (uint64_t j = 0; j < ws.num_jobs; j++) {
+                jobs[j].cores = ws.cores[j];
+                jobs[j].total_flops = ws.flops[j];
+                jobs[j].total_mem = ws.memory[j];
+            }
+            workloads.emplace_back(std::move(jobs), ws.outfile_sizes, ws.workload_type, ws.name, ws.arrival_time, ws.infile_datasets);
+            all_files.addDataset(workloads.back().outfiles.get());
+        }
+        workloads.back().upstream_workloads = ws.upstream_workloads;
+        workloads.back().output_storage = ws.output_storage;
+        workloads.back().cpu_scaling = CpuScaling(nlohmann::json::parse(ws.cpu_scaling));
+    }
+    // Input views of the jobs point into the files of all datasets and the output-files of all workloads
+    const FileList *files = nullptr;
+    for (size_t w = 0; w < cached_workloads.size(); w++) {
+        auto const &ws = cached_workloads[w];
+        if (ws.is_trace) {
+            if (ws.workload_type != WorkloadType::Calculation) {
+                workloads[w].assignFiles(datasets, workloads);
+            }
+            continue;
+        }
+        if (!files && ws.num_infiles > 0) {
+            files = FileArena::addFileList(all_files);
+        }
+        uint32_t *indices = FileArena::allocateIndices(ws.num_infiles);
+        std::copy(ws.infiles, ws.infiles + ws.num_infiles, indices);
+        for (uint64_t j = 0; j < ws.num_jobs; j++) {
+            workloads[w].job_batch[j].infiles = FileRange(files, indices + ws.infile_offsets[j], ws.infile_offsets[j + 1] - ws.infile_offsets[j]);
+        }
+    }
+    WRENCH_INFO("Loaded %zu datasets and %zu workloads from scenario cache %s", datasets.size(), workloads.size(), path.c_str());
+    return true;
+}
+
+/**
+ * @brief Write the sampled datasets and workloads of a scenario into a cache.
+ * The cache is written aside and moved into place, so that concurrent runs never map a partial cache.
+ *
+ * @param path Path of the scenario cache
+ * @param key Key of the scenario
+ * @param datasets Sampled datasets
+ * @param workloads Sampled workloads with their input-files assigned
+ *
+ * @throw std::runtime_error
+ */
+void ScenarioCache::store(const std::string &path, const uint64_t key,
+                          const std::vector<Dataset> &datasets, const std::vector<Workload> &workloads) {
+    std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+    std::ofstream out(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Scenario cache " + path + " could not be written!");
+    }
+    Writer writer(out);
+
+    Header header{};
+    std::memcpy(header.magic, ScenarioCache::magic, sizeof(header.magic));
+    header.version = ScenarioCache::version;
+    header.byte_order = byte_order;
+    header.key = key;
+    header.num_datasets = datasets.size();
+    header.num_workloads = workloads.size();
+    writer.bytes(&header, sizeof(header));
+
+    // Input-files are referred to by their index among the files of all datasets,
+    // followed by the output-files of all sampled workloads
+    std::unordered_map<const DatasetFiles *, uint64_t> dataset_offsets;
+    uint64_t num_files = 0;
+    for (auto const &ds: datasets) {
+        writer.str(ds.name);
+        writeStrings(writer, ds.hostnames);
+        dataset_offsets.emplace(ds.files.get(), num_files);
+        num_files += ds.files->size();
+        writer.array(ds.files->getSizes());
+    }
+    for (auto const &ws: workloads) {
+        if (ws.outfiles) {
+            dataset_offsets.emplace(ws.outfiles.get(), num_files);
+            num_files += ws.outfiles->size();
+        }
+    }
+
+    for (auto const &ws: workloads) {
+        writer.str(ws.name);
+        writer.u64(ws.workload_type);
+        writer.f64(ws.submit_arrival_time);
+        writeStrings(writer, ws.infile_datasets);
+        writeStrings(writer, ws.upstream_workloads);
+        writer.str(ws.output_storage);
+        writer.str(ws.cpu_scaling.getConfig().dump());
+        writer.u64(ws.trace ? 1 : 0);
+        if (ws.trace) {
+            writer.str(ws.trace->getPath());
+            writer.u64(ws.trace->getLookahead());
+            writer.f64(ws.trace->getCoreSpeed());
+            writer.str(ws.trace->getLFNDataset());
+            continue;
+        }
+        size_t num_jobs = ws.job_batch.size();
+        std::vector<int32_t> cores(num_jobs);
+        std::vector<double> flops(num_jobs);
+        std::vector<sg_size_t> memory(num_jobs);
+        std::vector<sg_size_t> outfile_sizes(num_jobs);
+        std::vector<uint64_t> infile_offsets(num_jobs + 1, 0);
+        std::vector<uint64_t> infiles;
+        for (size_t j = 0; j < num_jobs; j++) {
+            auto const &job = ws.job_batch[j];
+            cores[j] = job.cores;
+            flops[j] = job.total_flops;
+            memory[j] = job.total_mem;
+            outfile_sizes[j] = job.outfile_size;
+            // Input-files are located without registering them with the simulation
+            for (size_t i = 0; i < job.infiles.size(); i++) {
+                size_t index;
+                const DatasetFiles *dataset = job.infiles.getFileList()->locate(job.infiles.position(i), index);
+                auto offset = dataset_offsets.find(dataset);
+                if (offset == dataset_offsets.end()) {
+                    throw std::runtime_error("Input-file " + dataset->getID(index) + " of job " + job.jobid + " is not part of any dataset");
+                }
+                infiles.push_back(offset->second + index);
+            }
+            infile_offsets[j + 1] = infiles.size();
+        }
+        writer.array(cores);
+        writer.array(flops);
+        writer.array(memory);
+        writer.array(outfile_sizes);
+        writer.array(infile_offsets);
+        writer.array(infiles);
+    }
+
+    out.close();
+    if (!out || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("Scenario cache " + path + " could not be written!");
+    }
+}
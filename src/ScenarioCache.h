@@ -0,0 +1,40 @@
+
+
+#ifndef S_SCENARIOCACHE_H
+#define S_SCENARIOCACHE_H
+
+#include <wrench-dev.h>
+
+#include "Dataset.h"
+#include "Workload.h"
+
+/**
+ * @brief Binary cache of the sampled datasets and workloads of a scenario, which is written on the first run
+ * and memory-mapped on later runs with the same configurations and seed, skipping JSON parsing, sampling
+ * and file assignment.
+ *
+ * The file consists of a header and the datasets and workloads, with every string and array prefixed by
+ * its 64-bit length and padded to 8 bytes, so that the arrays of file sizes, job attributes and input-files
+ * can be addressed in place while parsing the mapping. The datasets and workloads are created by copying
+ * these arrays, and the mapping is released once they are loaded. Numbers are stored in the byte order of the host.
+ */
+class ScenarioCache {
+
+public:
+    static uint64_t key(unsigned int seed,
+                        const std::vector<std::string> &dataset_configurations,
+                        const std::vector<std::string> &workload_configurations);
+
+    static bool load(const std::string &path, uint64_t key,
+                     std::vector<Dataset> &datasets, std::vector<Workload> &workloads);
+
+    static void store(const std::string &path, uint64_t key,
+                      const std::vector<Dataset> &datasets, const std::vector<Workload> &workloads);
+
+    /** @brief magic number at the start of scenario caches */
+    static constexpr char magic[8] = {'D', 'C', 'S', 'S', 'C', 'E', 'N', 'E'};
+    /** @brief version of the scenario cache format, to be increased with any change of the format or of the sampling */
+    static constexpr uint32_t version = 7;
+};
+
+#endif//S_SCENARIOCACHE_H
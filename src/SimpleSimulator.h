@@ -6,6 +6,7 @@
 #include "LRU_FileList.h"
 #include "Workload.h"
 #include "Dataset.h"
+#include "util/Utils.h"
 
 class SimpleSimulator {
 
@@ -20,23 +21,43 @@ public:
     static std::set<std::string> file_registries; // hosts configured to manage a file registry
     static std::set<std::string> network_monitors;// hosts configured to monitor network
 
-    static void fillHostsInSiblingZonesMap(bool include_subzones);
+    static void fillHostsInSiblingZonesMap(bool include_subzones = false);
 
     static std::map<std::string, std::set<std::string>> hosts_in_zones;// map holding information of all hosts present in network zones
+    static std::map<std::string, int> cache_tiers;                     // tier of each cache host, lower tiers are looked up first
+    static std::map<std::string, EvictionPolicy> cache_eviction_policies;// eviction policy of each cache host
+    static bool cache_tiers_on;                                        // whether the platform declares a cache hierarchy
     static std::map<std::shared_ptr<wrench::StorageService>, LRU_FileList> global_file_map;// map holding files informations
 
     // global simulator settings and parameters
     static bool infile_caching_on;
     static bool prefetching_on;
     static bool local_cache_scope;
+    static CacheFillMode cache_fill_mode;
+    static unsigned int cache_write_queue;
+    static CacheGranularity cache_granularity;
+    static CacheAdmissionPolicy cache_admission;
+    static sg_size_t cache_admission_min_size;
+    static sg_size_t cache_admission_max_size;
+    static std::set<std::string> cache_admission_names;
+    static double cache_admission_probability;
+    static size_t cache_admission_ghost_size;
+    static CachePlacementStrategy cache_placement;
+    static ReplicaSelectionPolicy replica_selection;
+    static StageOutMode stage_out_mode;
+    static unsigned int stage_out_uploads;
 
     static bool shuffle_jobs;
 
     static sg_size_t xrd_block_size;
     static double xrd_add_flops_per_time;
     static double xrd_add_flops_local_per_time;
+    static StreamingMode xrd_streaming_mode;
+    static unsigned int xrd_readahead;
+    static unsigned int copy_concurrency;
     
     static std::mt19937 gen;
+    static unsigned int sampling_threads;
 
     /*// Cores required
     static int req_cores;
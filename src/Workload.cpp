@@ -2,10 +2,23 @@
 
 #include <utility>
 #include "Dataset.h"
+#include "SimpleSimulator.h"
+#include "sampling/ParallelFor.h"
+#include "sampling/Philox.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(workload, "Log category for WorkloadExecutionController");
 
 
+/**
+ * @brief Job attributes, each drawn from its own random stream
+ */
+enum JobAttribute : uint32_t {
+    JobCores,
+    JobFlops,
+    JobMemory,
+    JobOutfileSize
+};
+
 #define F(type) #type,
 const char *workload_type_names[] = {WORKLOAD_TYPES(F) nullptr};
 #undef F
@@ -37,8 +50,9 @@ std::string workload_type_to_string(const WorkloadType workload) {
  * @param workload_type: The workload type
  * @param name_suffix: part of job name to distinguish between different workloads
  * @param arrival_time: submission time offset relative to simulation start
- * @param generator: random number generator objects to draw from
+ * @param seed: seed of the random streams the job attributes are drawn from
  * @param infile_datasets the input file dataset
+ * @param file_assignment strategy assigning the files of the input datasets to the jobs
  * 
  * @throw std::runtime_error
  */
@@ -51,108 +65,143 @@ Workload::Workload(
         const enum WorkloadType workload_type,
         const std::string &name_suffix,
         const double arrival_time,
-        const std::mt19937 &generator,
-        const std::vector<std::string> &infile_datasets) {
-    this->generator = generator;
+        const unsigned int seed,
+        const std::vector<std::string> &infile_datasets,
+        const InfileAssignment &file_assignment) {
+    this->seed = seed;
+    this->name = name_suffix;
+    this->file_assignment = file_assignment;
     // Map to store the workload specification
     std::vector<JobSpecification> batch;
-    std::string potential_separator = (name_suffix.empty() ? "" : "_");
-
-    // Initialize random number generators
-    this->core_dist = Workload::createIntRNG(std::move(cores));
-    this->flops_dist = Workload::createDoubleRNG(std::move(flops));
-    this->mem_dist = Workload::createDoubleRNG(std::move(memory));
-    this->outsize_dist = Workload::createDoubleRNG(std::move(outfile_size));
-    batch.reserve(num_jobs);
-    for (size_t j = 0; j < num_jobs; j++) {
-        batch.push_back(sampleJob(j, name_suffix, potential_separator));
-    }
 
-    this->job_batch = batch;
+    // Initialize samplers, jobs run on at least one core and all other quantities are non-negative
+    this->core_dist = Sampler(cores, true, 1.);
+    this->flops_dist = Sampler(flops, false, 0.);
+    this->mem_dist = Sampler(memory, false, 0.);
+    this->outsize_dist = Sampler(outfile_size, false, 0.);
+    // Jobs are sampled in parallel, as each one draws from its own streams,
+    // while their output-files are only registered with the simulation when they are submitted
+    batch.resize(num_jobs);
+    std::vector<sg_size_t> outfile_sizes(num_jobs);
+    parallelFor(num_jobs, SimpleSimulator::sampling_threads, [&](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; j++) {
+            batch[j] = sampleJob(j, outfile_sizes[j]);
+        }
+    });
+    this->nameJobs(batch, outfile_sizes.data());
+
+    this->job_batch = std::move(batch);
     this->workload_type = workload_type;
     this->submit_arrival_time = arrival_time;
     if (!infile_datasets.empty())
         this->infile_datasets = infile_datasets;
 }
 
-std::function<double(std::mt19937 &)> Workload::createDoubleRNG(nlohmann::json json) {
-    // std::cerr << json["type"] << ": ";
-    std::function<double(std::mt19937 &)> dist;
-    if (json["type"].get<std::string>() == "gaussian") {
-        double ave = json["average"].get<double>();
-        double sigma = json["sigma"].get<double>();
-        // std::cerr << "ave: "<< ave << ", stddev: " << sigma << std::endl;
-        dist = [ave, sigma](std::mt19937 &generator) {
-            return std::normal_distribution<double>(ave, sigma)(generator);
-        };
-    } else if (json["type"].get<std::string>() == "histogram") {
-        auto bins = json["bins"].get<std::vector<double>>();
-        auto weights = json["counts"].get<std::vector<int>>();
-        // std::cerr << "bins: " << json["bins"] << ", weights: " << json["counts"] << std::endl;
-        dist = [bins, weights](std::mt19937 &generator) {
-            return std::piecewise_constant_distribution<double>(bins.begin(), bins.end(), weights.begin())(generator);
-        };
-    } else {
-        throw std::runtime_error("Random number generation for type " + json["type"].get<std::string>() + " not implemented for real valued distributions!");
-    }
-    return dist;
+/**
+ * @brief Create a Workload of jobs whose attributes have been sampled before
+ *
+ * @param jobs: jobs with their cores, flops, memory and input-files
+ * @param outfile_sizes: sizes of the jobs' output-files
+ * @param workload_type: The workload type
+ * @param name_suffix: part of job name to distinguish between different workloads
+ * @param arrival_time: submission time offset relative to simulation start
+ * @param infile_datasets the input file dataset
+ */
+Workload::Workload(
+        std::vector<JobSpecification> jobs,
+        const sg_size_t *outfile_sizes,
+        const enum WorkloadType workload_type,
+        const std::string &name_suffix,
+        const double arrival_time,
+        const std::vector<std::string> &infile_datasets) {
+    this->seed = 0;
+    this->name = name_suffix;
+    this->nameJobs(jobs, outfile_sizes);
+    this->job_batch = std::move(jobs);
+    this->workload_type = workload_type;
+    this->submit_arrival_time = arrival_time;
+    if (!infile_datasets.empty())
+        this->infile_datasets = infile_datasets;
 }
 
-std::function<int(std::mt19937 &)> Workload::createIntRNG(nlohmann::json json) {
-    // std::cerr << json["type"] << ": ";
-    std::function<int(std::mt19937 &)> dist;
-    if (json["type"].get<std::string>() == "poisson") {
-        int mu = json["mu"].get<int>();
-        // std::cerr << "ave: "<< ave << ", stddev: " << sigma << std::endl;
-        dist = [mu](std::mt19937 &generator) {
-            return std::poisson_distribution<int>(mu)(generator);
-        };
-    } else if (json["type"].get<std::string>() == "histogram") {
-        try {
-            auto bins = json["bins"].get<std::vector<double>>();
-            WRENCH_WARN("Ignoring configured bins for integer distribution!");
-        } catch (...) {}
-        auto weights = json["counts"].get<std::vector<int>>();
-        // std::cerr << "bins: " << json["bins"] << ", weights: " << json["counts"] << std::endl;
-        dist = [weights](std::mt19937 &generator) {
-            return std::discrete_distribution<int>(weights.begin(), weights.end())(generator);
-        };
-    } else {
-        throw std::runtime_error("Random number generation for type " + json["type"].get<std::string>() + " not implemented for integer valued distributions!");
+/**
+ * @brief Name the jobs and set the sizes of their output-files,
+ * which are kept as output-files of the workload for downstream workloads to read
+ *
+ * @param batch Jobs of the workload
+ * @param outfile_sizes Sizes of the jobs' output-files
+ */
+void Workload::nameJobs(std::vector<JobSpecification> &batch, const sg_size_t *outfile_sizes) {
+    std::string potential_separator = (this->name.empty() ? "" : "_");
+    this->outfiles = std::make_shared<DatasetFiles>(this->name, std::vector<sg_size_t>(outfile_sizes, outfile_sizes + batch.size()), true);
+    for (size_t j = 0; j < batch.size(); j++) {
+        batch[j].outfile_size = outfile_sizes[j];
+        batch[j].outfiles = this->outfiles.get();
+        batch[j].outfile_index = j;
+        batch[j].jobid = "job_" + this->name + potential_separator + std::to_string(j);
     }
-    return dist;
 }
 
+/**
+ * @brief Create a Workload replaying the jobs of a job trace, which are read
+ * while the simulation runs rather than sampled up front
+ *
+ * @param trace_path: path of the CSV or binary job trace
+ * @param trace_lookahead: maximal number of jobs read ahead to bring them into submission-time order
+ * @param core_speed: FLOPS per second of CPU time, for traces recording CPU times
+ * @param trace_lfn_dataset: infile dataset the input-files of the trace not named like DCSim files are assigned to, none if empty
+ * @param workload_type: The workload type
+ * @param name_suffix: part of job name to distinguish between different workloads
+ * @param arrival_time: submission time offset of the first job in the trace relative to simulation start
+ * @param infile_datasets the datasets the input-files in the trace belong to
+ *
+ * @throw std::runtime_error
+ */
+Workload::Workload(
+        const std::string &trace_path,
+        const size_t trace_lookahead,
+        const double core_speed,
+        const std::string &trace_lfn_dataset,
+        const enum WorkloadType workload_type,
+        const std::string &name_suffix,
+        const double arrival_time,
+        const std::vector<std::string> &infile_datasets) {
+    this->seed = 0;
+    this->name = name_suffix;
+    this->trace = std::make_shared<JobTrace>(trace_path, trace_lookahead, core_speed, trace_lfn_dataset);
+    this->workload_type = workload_type;
+    this->submit_arrival_time = arrival_time;
+    if (!infile_datasets.empty())
+        this->infile_datasets = infile_datasets;
+}
 
-JobSpecification Workload::sampleJob(const size_t job_id, const std::string &name_suffix, const std::string &potential_separator) {
+/**
+ * @brief Sample the attributes of a job, which are independent of the sampling of any other job
+ *
+ * @param job_id Index of the job in the workload
+ * @param outfile_size Sampled size of the job's output-file
+ * @return JobSpecification
+ */
+JobSpecification Workload::sampleJob(const size_t job_id, sg_size_t &outfile_size) const {
     // Create a job specification
     JobSpecification job_specification;
-
-    size_t j = job_id;
+    std::string stream = "workload/" + this->name;
 
     // Sample number of cores to run on
-    int req_cores = this->core_dist(this->generator);
-    while (req_cores < 1) req_cores = this->core_dist(this->generator);
-    job_specification.cores = req_cores;
+    PhiloxEngine cores_stream(this->seed, stream, job_id, JobAttribute::JobCores);
+    job_specification.cores = static_cast<int>(this->core_dist(cores_stream));
 
-    // Sample strictly positive task flops
-    double dflops = this->flops_dist(this->generator);
-    while (dflops < 0.) dflops = this->flops_dist(this->generator);
-    job_specification.total_flops = dflops;
+    // Sample non-negative task flops
+    PhiloxEngine flops_stream(this->seed, stream, job_id, JobAttribute::JobFlops);
+    job_specification.total_flops = this->flops_dist(flops_stream);
 
-    // Sample strictly positive task memory requirements
-    double dmem = this->mem_dist(this->generator);
-    while (dmem < 0.) dmem = this->mem_dist(this->generator);
-    auto dmem_in_bytes = static_cast<sg_size_t>(dmem);
-    job_specification.total_mem = dmem_in_bytes;
+    // Sample non-negative task memory requirements
+    PhiloxEngine mem_stream(this->seed, stream, job_id, JobAttribute::JobMemory);
+    job_specification.total_mem = static_cast<sg_size_t>(this->mem_dist(mem_stream));
 
     // Sample outfile sizes
-    double doutsize = this->outsize_dist(this->generator);
-    while (doutsize < 0.) doutsize = this->outsize_dist(this->generator);
-    auto doutsize_in_bytes = static_cast<sg_size_t>(doutsize);
-    job_specification.outfile = wrench::Simulation::addFile("outfile_" + name_suffix + potential_separator + std::to_string(j), doutsize_in_bytes);
-
-    job_specification.jobid = "job_" + name_suffix + potential_separator + std::to_string(j);
+    PhiloxEngine outsize_stream(this->seed, stream, job_id, JobAttribute::JobOutfileSize);
+    outfile_size = static_cast<sg_size_t>(this->outsize_dist(outsize_stream));
 
     return job_specification;
 }
@@ -166,31 +215,67 @@ void transform_if(InputIt first, InputIt last, OutputIt dest, Pred pred, Fct tra
     }
 }
 
-void Workload::assignFiles(std::vector<Dataset> const &dataset_specs) {
+/**
+ * @brief Assign the files of the infile datasets and the output-files of the upstream workloads to the jobs
+ *
+ * @param dataset_specs All datasets
+ * @param workload_specs All workloads, among which the upstream workloads are looked up
+ *
+ * @throw std::runtime_error
+ */
+void Workload::assignFiles(std::vector<Dataset> const &dataset_specs, std::vector<Workload> const &workload_specs) {
     std::vector<Dataset const *> matching_ds{};
     transform_if(
             dataset_specs.begin(), dataset_specs.end(), std::back_inserter(matching_ds), [&](Dataset const &ds) { return std::find(infile_datasets.begin(), infile_datasets.end(), ds.name) != infile_datasets.end(); },
             [&](Dataset const &ds) { return &ds; });
-    if (matching_ds.empty())
+    std::vector<Workload const *> upstream{};
+    for (auto const &upstream_name: this->upstream_workloads) {
+        auto ws = std::find_if(workload_specs.begin(), workload_specs.end(), [&](Workload const &ws) { return ws.name == upstream_name; });
+        if (ws == workload_specs.end())
+            throw std::runtime_error("ERROR: upstream workload " + upstream_name + " of workload " + this->name + " is not configured.");
+        if (!ws->outfiles)
+            throw std::runtime_error("ERROR: upstream workload " + upstream_name + " of workload " + this->name + " replays a job trace, whose output-files can't be read downstream.");
+        upstream.push_back(&*ws);
+    }
+    if (matching_ds.empty() && upstream.empty())
         throw std::runtime_error("ERROR: no valid infile dataset name in workload configuration.");
-    size_t num_files = std::accumulate(matching_ds.begin(), matching_ds.end(), 0, [](const int sum, Dataset const *ds) { return sum + ds->files.size(); });
-    std::vector<std::shared_ptr<wrench::DataFile>> all_files{};
-    all_files.reserve(num_files);
+    // Jobs view the files of all input datasets and upstream outputs, which are only registered with the simulation once a job accesses them
+    FileList all_files{};
     for (auto const &ds: matching_ds) {
-        std::copy(ds->files.begin(), ds->files.end(), std::back_inserter(all_files));
+        all_files.addDataset(ds->files.get());
+    }
+    for (auto const &ws: upstream) {
+        all_files.addDataset(ws->outfiles.get());
+    }
+    if (this->trace) {
+        // Input-files of replayed jobs are looked up by name when the jobs are submitted
+        this->trace->mapFiles(std::move(all_files));
+        return;
     }
     size_t num_jobs = job_batch.size();
     if (num_jobs == 0)
         return;
-    // int num_files = all_files.size();
-    size_t k = num_files / num_jobs;
+    size_t num_files = all_files.size();
+    const FileList *files = FileArena::addFileList(std::move(all_files));
+    this->file_assignment.prepare(num_files, num_jobs, this->seed, "assignment/" + this->name);
     std::cerr << "Assigning " << num_files << " files to " << num_jobs << " jobs\n";
-    for (auto j = 0; j < num_jobs; ++j) {
-        auto beg_it = all_files.begin() + j * k;
-        if (std::distance(beg_it, all_files.end()) < k) {
-            std::copy(beg_it, all_files.end(), std::back_inserter(job_batch[j].infiles));
-            break;
+    if (this->file_assignment.isContiguous()) {
+        for (size_t j = 0; j < num_jobs; j++) {
+            size_t offset, count;
+            this->file_assignment.getRange(j, offset, count);
+            job_batch[j].infiles = FileRange(files, offset, count);
         }
-        std::copy_n(beg_it, k, std::back_inserter(job_batch[j].infiles));
+        return;
     }
+    // Each job draws its files from its own stream into its own slot of the index list, so jobs are assigned their files in parallel
+    size_t slot_size = this->file_assignment.getInfilesPerJob();
+    uint32_t *indices = FileArena::allocateIndices(num_jobs * slot_size);
+    parallelFor(num_jobs, SimpleSimulator::sampling_threads, [&](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; j++) {
+            uint32_t *slot = indices + j * slot_size;
+            size_t count = 0;
+            this->file_assignment.assignJob(j, [&](size_t f) { slot[count++] = static_cast<uint32_t>(f); });
+            job_batch[j].infiles = FileRange(files, slot, count);
+        }
+    });
 }
@@ -5,6 +5,10 @@
 #include "JobSpecification.h"
 #include "util/Utils.h"
 #include "Dataset.h"
+#include "JobTrace.h"
+#include "sampling/Sampler.h"
+#include "sampling/InfileAssignment.h"
+#include "computation/CpuScaling.h"
 
 // #include <variant>
 
@@ -58,7 +62,24 @@ public:
             nlohmann::json memory,
             nlohmann::json outfile_size,
             WorkloadType workload_type, const std::string &name_suffix,
-            double arrival_time, const std::mt19937 &generator,
+            double arrival_time, unsigned int seed,
+            const std::vector<std::string> &infile_datasets = {},
+            const InfileAssignment &file_assignment = InfileAssignment());
+
+    Workload(
+            std::vector<JobSpecification> jobs,
+            const sg_size_t *outfile_sizes,
+            WorkloadType workload_type, const std::string &name_suffix,
+            double arrival_time,
+            const std::vector<std::string> &infile_datasets = {});
+
+    Workload(
+            const std::string &trace_path,
+            size_t trace_lookahead,
+            double core_speed,
+            const std::string &trace_lfn_dataset,
+            WorkloadType workload_type, const std::string &name_suffix,
+            double arrival_time,
             const std::vector<std::string> &infile_datasets = {});
 
     // job list with specifications
@@ -69,20 +90,31 @@ public:
     double submit_arrival_time;
     // infile dataset name
     std::vector<std::string> infile_datasets;
-    void assignFiles(std::vector<Dataset> const &);
+    // names of the workloads whose output-files the jobs read besides the infile datasets
+    std::vector<std::string> upstream_workloads;
+    // host of the GRID storage the output-files are uploaded to, the first GRID storage if empty
+    std::string output_storage;
+    // speedup of the jobs with their number of cores
+    CpuScaling cpu_scaling;
+    // workload name
+    std::string name;
+    // job trace replayed instead of sampled jobs, if any
+    std::shared_ptr<JobTrace> trace;
+    // output-files of the sampled jobs, which downstream workloads read
+    std::shared_ptr<DatasetFiles> outfiles;
+    void assignFiles(std::vector<Dataset> const &, std::vector<Workload> const &workloads = {});
 
 private:
-    /** @brief generator to shuffle jobs **/
-    std::mt19937 generator;
-    std::function<int(std::mt19937 &)> core_dist;
-    std::function<double(std::mt19937 &)> flops_dist;
-    std::function<double(std::mt19937 &)> mem_dist;
-    std::function<double(std::mt19937 &)> outsize_dist;
-
-    static std::function<int(std::mt19937 &)> createIntRNG(nlohmann::json json);
-    static std::function<double(std::mt19937 &)> createDoubleRNG(nlohmann::json json);
-
-    JobSpecification sampleJob(size_t job_id, const std::string &name_suffix, const std::string &potential_separator);
+    /** @brief seed of the random streams the jobs are sampled from **/
+    unsigned int seed;
+    Sampler core_dist;
+    Sampler flops_dist;
+    Sampler mem_dist;
+    Sampler outsize_dist;
+    InfileAssignment file_assignment;
+
+    JobSpecification sampleJob(size_t job_id, sg_size_t &outfile_size) const;
+    void nameJobs(std::vector<JobSpecification> &batch, const sg_size_t *outfile_sizes);
 };
 
 
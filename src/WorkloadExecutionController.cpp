@@ -17,6 +17,11 @@
 #include "computation/StreamedComputation.h"
 #include "computation/CopyComputation.h"
 #include "MonitorAction.h"
+#include "OutputUploader.h"
+#include "CacheWriter.h"
+#include "CachePlacement.h"
+#include "SimpleSimulator.h"
+#include "monitoring/NetworkMonitor.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(simple_wms, "Log category for WorkloadExecutionController");
 
@@ -33,7 +38,8 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(simple_wms, "Log category for WorkloadExecutionCont
  *  @param outputdump_name name of the file where the simulation's job information is stored
  *  @param shuffle_jobs switch to shuffle jobs for submission
  *  @param generator generator for job shuffling
- *  
+ *
+ *  @throw std::runtime_error if the workload's output storage is not a GRID storage
  */
 WorkloadExecutionController::WorkloadExecutionController(
         const Workload &workload_spec,
@@ -48,24 +54,47 @@ WorkloadExecutionController::WorkloadExecutionController(
         this->workload_spec[job_spec.jobid] = job_spec;
     }
     this->arrival_time = workload_spec.submit_arrival_time;
+    this->workload_name = workload_spec.name;
     this->workload_type = workload_spec.workload_type;
+    this->cpu_scaling = workload_spec.cpu_scaling;
+    this->trace = workload_spec.trace;
     this->job_scheduler = job_scheduler;
     this->grid_storage_services = grid_storage_services;
     this->cache_storage_services = cache_storage_services;
     this->filename = outputdump_name;
     this->shuffle_jobs = shuffle_jobs;
     this->generator = generator;
+
+    // Output-files go to the GRID storage on the host named by the workload, the first GRID storage by default
+    for (auto const &storage_service: grid_storage_services) {
+        if (workload_spec.output_storage.empty() || storage_service->getHostname() == workload_spec.output_storage) {
+            this->output_storage = storage_service;
+            break;
+        }
+    }
+    if (!this->output_storage) {
+        throw std::runtime_error("The output storage " + workload_spec.output_storage + " of workload " + this->workload_name +
+                                 " is not a GRID storage!");
+    }
 }
 
 /**
- * @brief Method to create a submit a job
+ * @brief Method to create a submit a job, registering its output-file with the simulation
  * @param job_name: the name of the job in the workload description
  * @param cs: the compute service on which to submit the job
  * @return the submitted job
  */
 std::shared_ptr<wrench::CompoundJob> WorkloadExecutionController::createAndSubmitJob(const std::string &job_name,
                                                                                      const std::shared_ptr<wrench::ComputeService> &cs) {
-    auto job_spec = this->workload_spec[job_name];
+    auto &job_spec = this->workload_spec[job_name];
+    if (job_spec.outfiles) {
+        // Output-files downstream workloads may read are registered with the output-files of the workload
+        job_spec.outfile = job_spec.outfiles->get(job_spec.outfile_index);
+    } else {
+        // Output-files of duplicated and replayed jobs are named like the ones of the workload, "outfile_<workload>_<index>",
+        // where duplicates are indexed past the original jobs
+        job_spec.outfile = wrench::Simulation::addFile(DatasetFiles::formatID("outfile", this->workload_name, job_spec.outfile_index), job_spec.outfile_size);
+    }
     auto job = job_manager->createCompoundJob(job_name);
 
     // Combined read-input-file-and-run-computation actions
@@ -74,9 +103,10 @@ std::shared_ptr<wrench::CompoundJob> WorkloadExecutionController::createAndSubmi
     if (this->workload_type == WorkloadType::Copy) {
         auto copy_computation = std::make_shared<CopyComputation>(
                 this->cache_storage_services, this->grid_storage_services, job_spec.infiles, job_spec.total_flops);
+        copy_computation->setWorkloadName(this->workload_name);
+        copy_computation->setCpuScaling(this->cpu_scaling, job_spec.cores);
 
         //? Split this into a caching file read and a standard compute action?
-        // TODO: figure out what is the best value for the ability to parallelize HEP workloads on a CPU. Setting speedup to number of cores for now
         run_action = std::make_shared<MonitorAction>(
                 "copycompute_" + job_name,
                 job_spec.total_mem, job_spec.cores,
@@ -89,8 +119,9 @@ std::shared_ptr<wrench::CompoundJob> WorkloadExecutionController::createAndSubmi
         auto streamed_computation = std::make_shared<StreamedComputation>(
                 this->cache_storage_services, this->grid_storage_services, job_spec.infiles, job_spec.total_flops,
                 SimpleSimulator::prefetching_on);
+        streamed_computation->setWorkloadName(this->workload_name);
+        streamed_computation->setCpuScaling(this->cpu_scaling, job_spec.cores);
 
-        // TODO: figure out what is the best value for the ability to parallelize HEP workloads on a CPU. Setting speedup to number of cores for now
         run_action = std::make_shared<MonitorAction>(
                 "streaming_" + job_name,
                 job_spec.total_mem, job_spec.cores,
@@ -101,20 +132,46 @@ std::shared_ptr<wrench::CompoundJob> WorkloadExecutionController::createAndSubmi
                 });
         job->addCustomAction(run_action);
     } else if (this->workload_type == WorkloadType::Calculation) {
-        // TODO: figure out what is the best value for the ability to parallelize HEP workloads on a CPU. Setting speedup to number of cores for now
         compute_action = job->addComputeAction(
                 "calculation_" + job_name,
                 job_spec.total_flops, job_spec.total_mem,
                 job_spec.cores, job_spec.cores,
-                wrench::ParallelModel::CONSTANTEFFICIENCY(1.0));
+                this->cpu_scaling.getParallelModel());
     } else {
         throw std::runtime_error("WorkloadType::" + workload_type_to_string(this->workload_type) + "not implemented!");
     }
 
-    // Create the file write action
-    auto fw_action = job->addFileWriteAction(
-            "file_write_" + job_name,
-            job_spec.outfile_destination);
+    // With local stage-out, the output-file is written onto a cache reachable from the execution host
+    // and uploaded to its GRID storage once the job has released its cores
+    std::shared_ptr<wrench::Action> fw_action;
+    if (SimpleSimulator::stage_out_mode == StageOutMode::LocalStageOut) {
+        auto outfile = job_spec.outfile;
+        fw_action = job->addCustomAction(
+                "stage_out_" + job_name,
+                0, 0,
+                [this, job_name, outfile](const std::shared_ptr<wrench::ActionExecutor> &action_executor) {
+                    auto reachable_caches = CacheComputation::findReachableCaches(action_executor->getHostname(), this->cache_storage_services);
+                    if (!reachable_caches.empty()) {
+                        auto staging = CachePlacement::pick(SimpleSimulator::cache_placement, reachable_caches.begin()->second, outfile);
+                        // Staged files awaiting their upload can't be evicted, so the cache may be full of them
+                        if (CacheComputation::freeSpace(staging, outfile->getSize(), outfile->getID())) {
+                            staging->writeFile(wrench::FileLocation::LOCATION(staging, outfile));
+                            this->outfile_stagings[job_name] = staging;
+                            return;
+                        }
+                    }
+                    WRENCH_DEBUG("No cache to stage out file %s onto from host %s, writing it to the GRID",
+                                 outfile->getID().c_str(), action_executor->getHostname().c_str());
+                    this->output_storage->writeFile(wrench::FileLocation::LOCATION(this->output_storage, outfile));
+                },
+                [](const std::shared_ptr<wrench::ActionExecutor> &action_executor) {
+                    // Do nothing
+                });
+    } else {
+        fw_action = job->addFileWriteAction(
+                "file_write_" + job_name,
+                wrench::FileLocation::LOCATION(this->output_storage, job_spec.outfile));
+    }
     // //TODO: Think of a determination of storage_service to hold output data
     // // auto fw_action = job->addCustomAction(
     // //     "file_write_" + *job_name,
@@ -141,6 +198,7 @@ std::shared_ptr<wrench::CompoundJob> WorkloadExecutionController::createAndSubmi
     // Submit the job
     WRENCH_INFO("Submitting job %s to compute service %s...", job->getName().c_str(), cs->getName().c_str());
     job_manager->submitJob(job, cs);
+    this->num_jobs_in_flight++;
     return job;
 }
 
@@ -157,7 +215,7 @@ void WorkloadExecutionController::setJobSubmitted(const std::string &job_name) {
 
 
 /**
- * @brief Method to determine whether all jobs have been submitted
+ * @brief Method to determine whether all jobs ready for submission have been submitted
  * @return True is all jobs have been submitted, false otherwise
  */
 bool WorkloadExecutionController::isWorkloadEmpty() const {
@@ -165,6 +223,123 @@ bool WorkloadExecutionController::isWorkloadEmpty() const {
 }
 
 
+/**
+ * @brief Add a workload reading the output-files of this one
+ * @param downstream: the execution controller of the downstream workload
+ */
+void WorkloadExecutionController::addDownstream(WorkloadExecutionController *downstream) {
+    this->downstream_controllers.push_back(downstream);
+    downstream->num_upstream++;
+}
+
+
+/**
+ * @brief Add a job to the workload, which is held back until upstream workloads have written all its input-files
+ * @param job_name: the name of the job in the workload description
+ * @param job_spec: the job
+ */
+void WorkloadExecutionController::queueJob(const std::string &job_name, JobSpecification job_spec) {
+    size_t num_missing = 0;
+    for (size_t i = 0; i < job_spec.infiles.size(); i++) {
+        size_t index;
+        DatasetFiles *files = job_spec.infiles.getFileList()->locate(job_spec.infiles.position(i), index);
+        if (!files->isAvailable(index)) {
+            this->jobs_awaiting_input[{files, index}].push_back(job_name);
+            num_missing++;
+        }
+    }
+    if (num_missing == 0) {
+        this->workload_spec[job_name] = std::move(job_spec);
+    } else {
+        this->waiting_jobs[job_name] = {std::move(job_spec), num_missing};
+    }
+}
+
+
+/**
+ * @brief Release the jobs waiting for an output-file of an upstream workload which has just been written
+ * @param files: the output-files of the upstream workload
+ * @param index: the index of the file written
+ */
+void WorkloadExecutionController::releaseDependentJobs(DatasetFiles *files, const size_t index) {
+    auto awaiting = this->jobs_awaiting_input.find({files, index});
+    if (awaiting == this->jobs_awaiting_input.end()) {
+        return;
+    }
+    bool released = false;
+    for (auto const &job_name: awaiting->second) {
+        auto waiting = this->waiting_jobs.find(job_name);
+        if (--waiting->second.second == 0) {
+            WRENCH_DEBUG("All input-files of job %s have been written", job_name.c_str());
+            this->workload_spec[job_name] = std::move(waiting->second.first);
+            this->waiting_jobs.erase(waiting);
+            released = true;
+        }
+    }
+    this->jobs_awaiting_input.erase(awaiting);
+    if (released) {
+        this->wakeUp();
+    }
+}
+
+
+/**
+ * @brief Make the output-file of a completed job available to the downstream workloads,
+ * which read it from the GRID storage it was written to
+ * @param job_spec: the completed job
+ */
+void WorkloadExecutionController::publishOutput(const JobSpecification &job_spec) {
+    if (!job_spec.outfiles || this->downstream_controllers.empty()) {
+        return;
+    }
+    SimpleSimulator::global_file_map[this->output_storage].touchFile(job_spec.outfile.get());
+    job_spec.outfiles->setAvailable(job_spec.outfile_index);
+    for (auto const &downstream: this->downstream_controllers) {
+        downstream->releaseDependentJobs(job_spec.outfiles, job_spec.outfile_index);
+    }
+}
+
+
+/**
+ * @brief Notify that an upstream workload has terminated and is not going to write any more output-files
+ */
+void WorkloadExecutionController::upstreamFinished() {
+    this->num_upstream_finished++;
+    this->wakeUp();
+}
+
+
+/**
+ * @brief Wake up the main loop waiting for the next event, so that it schedules released jobs
+ * or gives up on jobs no upstream workload is going to write the input-files of.
+ * Upstream workloads call it from their own actors, hence the wake-up is delivered as a timer event.
+ */
+void WorkloadExecutionController::wakeUp() {
+    if (this->wake_up_pending || this->terminated) {
+        return;
+    }
+    this->wake_up_pending = true;
+    this->setTimer(wrench::Simulation::getCurrentSimulatedDate(), "upstream progress");
+}
+
+
+/**
+ * @brief Add the jobs of the replayed job trace submitted by now to the workload
+ * @return the number of jobs added
+ */
+size_t WorkloadExecutionController::releaseTraceJobs() {
+    size_t num_released = 0;
+    double now = wrench::Simulation::getCurrentSimulatedDate();
+    while (this->trace->hasNext() && this->arrival_time + this->trace->peekSubmitTime() <= now) {
+        auto job_spec = this->trace->next(this->workload_name);
+        std::string job_name = job_spec.jobid;
+        this->queueJob(job_name, std::move(job_spec));
+        num_released++;
+    }
+    return num_released;
+}
+
+
 /**
  * @brief main method of the WorkloadExecutionController daemon
  * 
@@ -189,6 +364,16 @@ int WorkloadExecutionController::main() {
     // this->data_movement_manager = this->createDataMovementManager();
     // WRENCH_INFO("Created a data manager");
 
+    // Hold back the jobs reading output-files upstream workloads have not written yet
+    if (this->num_upstream > 0) {
+        auto jobs = std::move(this->workload_spec);
+        this->workload_spec.clear();
+        for (auto &job: jobs) {
+            this->queueJob(job.first, std::move(job.second));
+        }
+        WRENCH_INFO("%zu jobs wait for output-files of upstream workloads", this->waiting_jobs.size());
+    }
+
     // Shuffle jobs for submission
     std::vector<const std::string *> job_spec_keys;
     job_spec_keys.reserve(this->workload_spec.size());
@@ -208,14 +393,36 @@ int WorkloadExecutionController::main() {
     WRENCH_INFO("There are %ld jobs to schedule at time %f", this->workload_spec.size(), this->arrival_time);
 
     // Main loop
-    size_t total_num_jobs = this->workload_spec.size();
-    while ((this->num_completed_jobs < total_num_jobs) && (!this->abort)) {
+    size_t total_num_jobs = this->workload_spec.size() + this->waiting_jobs.size();
+    while (((this->num_completed_jobs < total_num_jobs) || (this->trace && this->trace->hasNext())) && (!this->abort)) {
+
+        // Add the replayed jobs submitted in the meantime
+        if (this->trace) {
+            total_num_jobs += this->releaseTraceJobs();
+        }
 
         // Invoke the scheduler
         this->job_scheduler->schedule();
 
+        // Give up on jobs whose input-files no upstream workload is going to write anymore
+        if (!this->waiting_jobs.empty() && this->workload_spec.empty() && this->num_jobs_in_flight == 0 &&
+            this->num_upstream_finished == this->num_upstream) {
+            WRENCH_INFO("%zu jobs wait for output-files which upstream workloads failed to write", this->waiting_jobs.size());
+            this->abort = true;
+            continue;
+        }
+
         try {
-            this->waitForAndProcessNextEvent();
+            double timeout = -1.;
+            if (this->trace && this->trace->hasNext()) {
+                // Wake up in time for the submission of the next replayed job
+                timeout = std::max(this->arrival_time + this->trace->peekSubmitTime() - wrench::Simulation::getCurrentSimulatedDate(), 0.);
+            }
+            if (timeout >= 0.) {
+                this->waitForAndProcessNextEvent(timeout);
+            } else {
+                this->waitForAndProcessNextEvent();
+            }
         } catch (wrench::ExecutionException &e) {
             WRENCH_INFO("Error while getting next execution event (%s)... ignoring and trying again",
                         (e.getCause()->toString().c_str()));
@@ -223,10 +430,21 @@ int WorkloadExecutionController::main() {
         }
     }
 
+    this->terminated = true;
+
+    // Outputs still being uploaded and data still queued for writing into caches
+    // are lost once the last execution controller terminates
+    OutputUploader::waitForUploads();
+    CacheWriter::waitForWrites();
+
+    for (auto const &downstream: this->downstream_controllers) {
+        downstream->upstreamFinished();
+    }
+
     wrench::Simulation::sleep(10);
 
     WRENCH_INFO("--------------------------------------------------------");
-    if (this->workload_spec.empty()) {
+    if (this->workload_spec.empty() && this->waiting_jobs.empty()) {
         WRENCH_INFO("Workload execution on %s is complete!", this->getHostname().c_str());
     } else {
         WRENCH_INFO("Workload execution on %s is incomplete!", this->getHostname().c_str());
@@ -252,11 +470,23 @@ WorkloadExecutionController::processEventCompoundJobFailure(const std::shared_pt
     WRENCH_INFO("Notified that compound job %s has failed!", event->job->getName().c_str());
     WRENCH_INFO("Failure cause: %s", event->failure_cause->toString().c_str());
     WRENCH_INFO("As a WorkloadExecutionController, I abort as soon as there is a failure");
+    this->num_jobs_in_flight--;
     this->num_completed_jobs++;
     this->abort = true;
 }
 
 
+/**
+ * @brief Process a timer event, which wakes up the main loop
+ * to schedule jobs released by upstream workloads
+ *
+ * @param event: a timer event
+ */
+void WorkloadExecutionController::processEventTimer(const std::shared_ptr<wrench::TimerEvent> &event) {
+    this->wake_up_pending = false;
+}
+
+
 /**
 * @brief Process a ExecutionEvent::COMPOUND_JOB_COMPLETION.
 * This also writes out a dump of job information returned by the simulation.
@@ -267,11 +497,34 @@ void WorkloadExecutionController::processEventCompoundJobCompletion(
         const std::shared_ptr<wrench::CompoundJobCompletedEvent> &event) {
 
     this->job_scheduler->jobDone(event->job);
+    this->num_jobs_in_flight--;
     this->num_completed_jobs++;
 
     auto job_name = event->job->getName();
     auto job_spec = this->workload_spec_submitted[job_name];
     this->workload_spec_submitted.erase(job_name); // clean up memory
+    auto staging = this->outfile_stagings.find(job_name);
+    if (staging != this->outfile_stagings.end()) {
+        job_spec.outfile_staging = staging->second;
+        this->outfile_stagings.erase(staging);
+    }
+
+    // A staged-out output-file becomes available downstream once uploaded. The staged copy is dropped then,
+    // unless downstream workloads read it, in which case it stays in the cache like any cached input-file.
+    if (job_spec.outfile_staging) {
+        bool read_downstream = job_spec.outfiles && !this->downstream_controllers.empty();
+        OutputUploader::upload(job_spec.outfile_staging, job_spec.outfile, this->output_storage, [this, job_spec, read_downstream]() {
+            auto staged = wrench::FileLocation::LOCATION(job_spec.outfile_staging, job_spec.outfile);
+            if (read_downstream) {
+                SimpleSimulator::global_file_map[job_spec.outfile_staging].touchFile(job_spec.outfile.get());
+            } else {
+                job_spec.outfile_staging->deleteFile(staged);
+            }
+            this->publishOutput(job_spec);
+        });
+    } else {
+        this->publishOutput(job_spec);
+    }
 
     /* Retrieve the job that this event is for */
     WRENCH_INFO("Notified that job %s with %ld actions has completed", job_name.c_str(),
@@ -285,6 +538,7 @@ void WorkloadExecutionController::processEventCompoundJobCompletion(
     double incr_infile_transfertime = 0.;
     sg_size_t incr_infile_size = 0.;
     double incr_outfile_transfertime = 0.;
+    double outfile_start_date = wrench::Simulation::getCurrentSimulatedDate();
     sg_size_t incr_outfile_size = 0.;
     double global_start_date = DBL_MAX;
     double global_end_date = DBL_MIN;
@@ -326,9 +580,12 @@ void WorkloadExecutionController::processEventCompoundJobCompletion(
                         "Some of the job information for action " + monitor_action->getName() +
                         " has already been filled. Abort!");
             }
-        } else if (auto file_write_action = std::dynamic_pointer_cast<wrench::FileWriteAction>(action)) {
+        } else if (std::dynamic_pointer_cast<wrench::FileWriteAction>(action) ||
+                   std::dynamic_pointer_cast<wrench::CustomAction>(action)) {
+            // Writing the output-file, either to its GRID storage or onto the cache it is staged out onto
             if (end_date >= start_date) {
                 incr_outfile_transfertime += end_date - start_date;
+                outfile_start_date = start_date;
             } else {
                 throw std::runtime_error(
                         "Writing outputfile " + job_spec.outfile->getID() +
@@ -353,6 +610,7 @@ void WorkloadExecutionController::processEventCompoundJobCompletion(
         incr_infile_size += f->getSize();
     }
     incr_outfile_size += job_spec.outfile->getSize();
+    NetworkMonitor::recordWrite(job_spec.outfile_staging ? job_spec.outfile_staging : this->output_storage, incr_outfile_size, outfile_start_date);
 
     /* Dump relevant information to file */
     this->filedump.open(this->filename, ios::out | ios::app);
@@ -50,17 +50,45 @@ public:
 
     bool isWorkloadEmpty() const;
 
+    void addDownstream(WorkloadExecutionController *downstream);
+    void releaseDependentJobs(DatasetFiles *files, size_t index);
+    void upstreamFinished();
+
+    const std::string &getWorkloadName() const {
+        return this->workload_name;
+    }
+
+    size_t getNumCompletedJobs() const {
+        return this->num_completed_jobs;
+    }
+
+    size_t getNumJobsInFlight() const {
+        return this->num_jobs_in_flight;
+    }
+
+    size_t getNumJobsQueued() const {
+        return this->workload_spec.size();
+    }
+
 protected:
     void processEventCompoundJobFailure(const std::shared_ptr<wrench::CompoundJobFailedEvent>& event) override;
     void processEventCompoundJobCompletion(const std::shared_ptr<wrench::CompoundJobCompletedEvent>& event) override;
+    void processEventTimer(const std::shared_ptr<wrench::TimerEvent> &event) override;
 
 private:
+    size_t releaseTraceJobs();
+    void queueJob(const std::string &job_name, JobSpecification job_spec);
+    void publishOutput(const JobSpecification &job_spec);
+    void wakeUp();
+
     std::map<std::string, JobSpecification> workload_spec;
     std::map<std::string, JobSpecification> workload_spec_submitted;
     std::shared_ptr<JobScheduler> job_scheduler;
 
     std::set<std::shared_ptr<wrench::StorageService>> grid_storage_services;
     std::set<std::shared_ptr<wrench::StorageService>> cache_storage_services;
+    /** @brief GRID storage the output-files of the workload are written or uploaded to **/
+    std::shared_ptr<wrench::StorageService> output_storage;
 
     int main() override;
 
@@ -90,14 +118,38 @@ private:
     /** @brief time to wait before submission **/
     double arrival_time = 0.;
 
+    /** @brief name of the workload */
+    std::string workload_name;
+
     /** @brief job type for this workload*/
     WorkloadType workload_type;
 
+    /** @brief speedup of the jobs with their number of cores **/
+    CpuScaling cpu_scaling;
+
     /** @brief switch to shuffle jobs **/
     bool shuffle_jobs = false;
 
     /** @brief generator to shuffle jobs **/
     std::mt19937 generator;
+
+    /** @brief job trace replayed, whose jobs are added to the workload when submitted in the trace **/
+    std::shared_ptr<JobTrace> trace;
+
+    /** @brief execution controllers of the workloads reading the output-files of this one **/
+    std::vector<WorkloadExecutionController *> downstream_controllers;
+    /** @brief number of workloads whose output-files this one reads, and how many of them have terminated **/
+    size_t num_upstream = 0;
+    size_t num_upstream_finished = 0;
+    /** @brief jobs waiting for output-files of upstream workloads, with their number of input-files not written yet **/
+    std::map<std::string, std::pair<JobSpecification, size_t>> waiting_jobs;
+    /** @brief names of the waiting jobs reading each output-file not written yet **/
+    std::map<std::pair<DatasetFiles *, size_t>, std::vector<std::string>> jobs_awaiting_input;
+    /** @brief caches the stage-out actions of running jobs have written their output-files onto **/
+    std::map<std::string, std::shared_ptr<wrench::StorageService>> outfile_stagings;
+    /** @brief whether a wake-up of the main loop is underway, and whether the main loop has terminated **/
+    bool wake_up_pending = false;
+    bool terminated = false;
 };
 
 #endif//DCSIM_WORKLOAD_EXECUTION_CONTROLLER_H
@@ -0,0 +1,125 @@
+#include <wrench-dev.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(async_read, "Log category for AsyncRead");
+
+#include "AsyncRead.h"
+#include "monitoring/NetworkMonitor.h"
+
+
+/**
+ * @brief Start reading a number of bytes of a file from its location
+ * into the memory of the host the calling actor is running on
+ *
+ * @param location Location of the file to read
+ * @param num_bytes Number of bytes to read
+ *
+ * @throw std::runtime_error
+ */
+AsyncRead::AsyncRead(const std::shared_ptr<wrench::FileLocation> &location, const sg_size_t num_bytes) : location(location),
+                                                                                                      num_bytes(num_bytes) {
+    std::string source_hostname = location->getStorageService()->getHostname();
+    auto disk = AsyncRead::getStorageDisk(source_hostname);
+    if (!disk) {
+        throw std::runtime_error("Storage host " + source_hostname + " has no disk to read file " + location->getFile()->getID() + " from!");
+    }
+    this->start_time = wrench::Simulation::getCurrentSimulatedDate();
+    this->io = disk->read_async(num_bytes);
+    this->comm = simgrid::s4u::Comm::sendto_async(simgrid::s4u::Host::by_name(source_hostname),
+                                                  simgrid::s4u::this_actor::get_host(),
+                                                  num_bytes);
+    this->pending = {this->io, this->comm};
+}
+
+/**
+ * @brief Block until the read has completed
+ */
+void AsyncRead::wait() {
+    if (this->isDone()) return;
+    this->io->wait();
+    this->comm->wait();
+    this->pending.clear();
+    NetworkMonitor::recordRead(this->location->getStorageService(), this->num_bytes, this->start_time);
+}
+
+/**
+ * @brief Block until any of the given outstanding reads has completed,
+ * which is removed from the list
+ *
+ * @param reads Outstanding reads
+ * @return the completed read
+ *
+ * @throw std::runtime_error
+ */
+std::shared_ptr<AsyncRead> AsyncRead::waitAny(std::vector<std::shared_ptr<AsyncRead>> &reads) {
+    if (reads.empty()) {
+        throw std::runtime_error("Waiting for any of no outstanding reads!");
+    }
+    simgrid::s4u::ActivitySet activities;
+    for (auto const &read: reads) {
+        for (auto const &activity: read->pending) activities.push(activity);
+    }
+    while (true) {
+        for (auto it = reads.begin(); it != reads.end(); ++it) {
+            if ((*it)->isDone()) {
+                auto done = *it;
+                reads.erase(it);
+                NetworkMonitor::recordRead(done->location->getStorageService(), done->num_bytes, done->getStartTime());
+                return done;
+            }
+        }
+        auto activity = activities.wait_any();
+        for (auto const &read: reads) {
+            auto &pending = read->pending;
+            pending.erase(std::remove(pending.begin(), pending.end(), activity), pending.end());
+        }
+    }
+}
+
+/**
+ * @brief Finish date of the read, i.e. when both the disk read and the transfer are done
+ *
+ * @return double
+ */
+double AsyncRead::getEndTime() const {
+    return std::max(this->io->get_finish_time(), this->comm->get_finish_time());
+}
+
+/**
+ * @brief Time during which at least one of the given completed reads was in flight,
+ * such that overlapping reads are accounted once
+ *
+ * @param reads Completed reads
+ * @return double
+ */
+double AsyncRead::getBusyTime(std::vector<std::shared_ptr<AsyncRead>> reads) {
+    std::sort(reads.begin(), reads.end(), [](const std::shared_ptr<AsyncRead> &a, const std::shared_ptr<AsyncRead> &b) {
+        return a->getStartTime() < b->getStartTime();
+    });
+    double busy_time = 0.;
+    double busy_start = 0.;
+    double busy_end = -1.;
+    for (auto const &read: reads) {
+        if (read->getStartTime() > busy_end) {
+            if (busy_end > busy_start) busy_time += busy_end - busy_start;
+            busy_start = read->getStartTime();
+        }
+        busy_end = std::max(busy_end, read->getEndTime());
+    }
+    if (busy_end > busy_start) busy_time += busy_end - busy_start;
+    return busy_time;
+}
+
+/**
+ * @brief Disk of a host the storage service on it is mounted on
+ *
+ * @param hostname Name of the storage host
+ * @return the disk mounted at "/" or, if there is none, the first disk of the host
+ */
+simgrid::s4u::Disk *AsyncRead::getStorageDisk(const std::string &hostname) {
+    simgrid::s4u::Disk *disk = nullptr;
+    for (auto const &d: simgrid::s4u::Host::by_name(hostname)->get_disks()) {
+        auto mount = d->get_property("mount");
+        if (!disk || (mount && std::string(mount) == "/")) disk = d;
+    }
+    return disk;
+}
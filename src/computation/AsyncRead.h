@@ -0,0 +1,47 @@
+
+
+#ifndef S_ASYNCREAD_H
+#define S_ASYNCREAD_H
+
+#include <wrench-dev.h>
+
+/**
+ * @brief Non-blocking read of (a part of) a file from a storage service,
+ * modelled directly as a disk read on the storage host overlapping with
+ * the network transfer to the reading host.
+ * Unlike wrench::StorageService::readFile several of these can be outstanding in the same actor.
+ */
+class AsyncRead {
+
+public:
+    AsyncRead(const std::shared_ptr<wrench::FileLocation> &location, sg_size_t num_bytes);
+
+    void wait();
+
+    static std::shared_ptr<AsyncRead> waitAny(std::vector<std::shared_ptr<AsyncRead>> &reads);
+
+    static double getBusyTime(std::vector<std::shared_ptr<AsyncRead>> reads);
+
+    static simgrid::s4u::Disk *getStorageDisk(const std::string &hostname);
+
+    [[nodiscard]] bool isDone() const { return this->pending.empty(); }
+
+    [[nodiscard]] double getStartTime() const { return this->start_time; }
+
+    [[nodiscard]] double getEndTime() const;
+
+    [[nodiscard]] sg_size_t getNumBytes() const { return this->num_bytes; }
+
+    [[nodiscard]] const std::shared_ptr<wrench::FileLocation> &getLocation() const { return this->location; }
+
+private:
+    std::shared_ptr<wrench::FileLocation> location;
+    sg_size_t num_bytes;
+    double start_time;
+    simgrid::s4u::IoPtr io;
+    simgrid::s4u::CommPtr comm;
+    // activities not yet completed
+    std::vector<simgrid::s4u::ActivityPtr> pending;
+};
+
+#endif//S_ASYNCREAD_H
@@ -4,6 +4,15 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(cache_computation, "Log category for CacheComputati
 
 #include "CacheComputation.h"
 #include "../MonitorAction.h"
+#include "../CacheAdmission.h"
+#include "../CachePlacement.h"
+#include "../CacheWriter.h"
+#include "../ReplicaSelection.h"
+#include "../BlockCacheIndex.h"
+#include "AsyncRead.h"
+#include "../monitoring/CacheMonitor.h"
+#include "../monitoring/NetworkMonitor.h"
+#include "../monitoring/Profiler.h"
 
 //#define SIMULATE_FILE_LOOKUP_OPERATION 1
 
@@ -19,7 +28,7 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(cache_computation, "Log category for CacheComputati
  */
 CacheComputation::CacheComputation(const std::set<std::shared_ptr<wrench::StorageService>> &cache_storage_services,
                                    const std::set<std::shared_ptr<wrench::StorageService>> &grid_storage_services,
-                                   const std::vector<std::shared_ptr<wrench::DataFile>> &files,
+                                   const FileRange &files,
                                    const double total_flops) : total_flops_(total_flops) {
     this->cache_storage_services = cache_storage_services;
     this->grid_storage_services = grid_storage_services;
@@ -42,61 +51,76 @@ CacheComputation::CacheComputation(const std::set<std::shared_ptr<wrench::Storag
 void CacheComputation::determineFileSourcesAndCache(const std::shared_ptr<wrench::ActionExecutor>& action_executor, bool cache_files = true) {
 
     std::string hostname = action_executor->getHostname();// host where action is executed
-    auto host = simgrid::s4u::Host::by_name(hostname);
-    std::string netzone = host->get_englobing_zone()->get_name();                            // network zone executing host belongs to
     auto the_action = std::dynamic_pointer_cast<MonitorAction>(action_executor->getAction());// executed action
 
     sg_size_t cached_data_size = 0;
     sg_size_t remote_data_size = 0;
 
     // Identify all cache storage services that can be reached from
-    // this host, which runs the streaming action
-    std::vector<std::shared_ptr<wrench::StorageService>> matched_storage_services;
-
-    for (auto const &ss: this->cache_storage_services) {
-        bool host_in_scope = false;
-        if (SimpleSimulator::local_cache_scope) {
-            host_in_scope = (ss->getHostname() == hostname);
-        } else {
-            host_in_scope = (SimpleSimulator::hosts_in_zones[netzone].find(ss->getHostname()) != SimpleSimulator::hosts_in_zones[netzone].end());
-        }
-        if (host_in_scope) {
-            matched_storage_services.push_back(ss);
-            WRENCH_DEBUG("Found a reachable cache on host %s", ss->getHostname().c_str());
-        }
-    }
+    // this host, which runs the streaming action, grouped by their tier
+    auto matched_storage_services = CacheComputation::findReachableCaches(hostname, this->cache_storage_services);
     if (matched_storage_services.empty()) {
         WRENCH_DEBUG("Couldn't find a reachable cache");
     }
+    // With block granularity, blocks are looked up in the caches while reading
+    bool block_granularity = (SimpleSimulator::cache_granularity == CacheGranularity::BlockGranularity);
+    if (block_granularity) {
+        for (auto const &tier: matched_storage_services) {
+            this->block_caches.insert(this->block_caches.end(), tier.second.begin(), tier.second.end());
+        }
+    }
 
 
     // For each file, identify where to read it from and/or deal with cache updates, etc.
     for (auto const &f: this->files) {
         // find a source providing the required file
         std::shared_ptr<wrench::StorageService> source_ss;
-        // See whether the file is already available in a "reachable" cache storage service
-        for (auto const &ss: matched_storage_services) {
+        // See whether the file is already available in a "reachable" cache storage service, walking the tiers in order
+        auto hit_tier = matched_storage_services.end();
+        for (auto tier = matched_storage_services.begin(); tier != matched_storage_services.end() && !source_ss && !block_granularity; ++tier) {
+            for (auto const &ss: tier->second) {
+                DCSIM_PROFILE_COUNT(CacheLookups, 1);
 #ifdef SIMULATE_FILE_LOOKUP_OPERATION
-            bool has_file = ss->lookupFile(f, wrench::FileLocation::LOCATION(ss));
+                bool has_file = ss->lookupFile(f, wrench::FileLocation::LOCATION(ss));
 #else
-            bool has_file = SimpleSimulator::global_file_map[ss].hasFile(f);
+                bool has_file = SimpleSimulator::global_file_map[ss].hasFile(f);
 #endif
-            if (has_file) {
-                source_ss = ss;
-                WRENCH_DEBUG("Found file %s with size %llu in cache %s", f->getID().c_str(), f->getSize(), source_ss->getHostname().c_str());
-                cached_data_size += f->getSize();
-                break;
+                if (has_file) {
+                    source_ss = ss;
+                    hit_tier = tier;
+                    WRENCH_DEBUG("Found file %s with size %llu in cache %s", f->getID().c_str(), f->getSize(), source_ss->getHostname().c_str());
+                    cached_data_size += f->getSize();
+                    break;
+                }
             }
         }
-        // If yes, we're done
+        // If yes, we're done, apart from promoting the file into the tiers below
         if (source_ss) {
+            // The file may still be on its way into the cache, then wait for its blocks while reading.
+            // A file listed twice by the job may be filled by the job itself, whose first read feeds the fill.
+            auto fill = CacheFill::find(source_ss, f.get());
+            auto own_fills = this->cache_fills_to_feed.find(f.get());
+            bool own_fill = (own_fills != this->cache_fills_to_feed.end() &&
+                             std::find(own_fills->second.begin(), own_fills->second.end(), fill) != own_fills->second.end());
+            if (fill && !own_fill && this->cache_fills_to_await.find(f.get()) == this->cache_fills_to_await.end()) {
+                WRENCH_DEBUG("File %s is being written into cache %s, collapsing request", f->getID().c_str(), source_ss->getHostname().c_str());
+                this->cache_fills_to_await[f.get()] = fill;
+            }
+            CacheMonitor::recordHit(source_ss, f->getSize());
+            CachePlacement::addTransfer(source_ss);
+            this->cache_transfers.push_back(source_ss);
             SimpleSimulator::global_file_map[source_ss].touchFile(f.get());
+            bool admitted = (hit_tier == matched_storage_services.begin() ||
+                             CacheAdmission::admit(SimpleSimulator::cache_admission, f, this->workload_name));
+            for (auto tier = matched_storage_services.begin(); tier != hit_tier; ++tier) {
+                cacheFile(f, tier->second, admitted, cache_files);
+            }
             // this->file_sources[f] = wrench::FileLocation::LOCATION(source_ss, f);
             file_sources.emplace_back(f, wrench::FileLocation::LOCATION(source_ss, f));
             continue;
         }
         // If not, then we have to copy the file from some GRID source to some reachable cache storage service
-        // TODO: Find the optimal GRID source, whatever that means (right now it's whichever one works first)
+        std::vector<std::shared_ptr<wrench::StorageService>> replicas;
         for (auto const &ss: this->grid_storage_services) {
 #ifdef SIMULATE_FILE_LOOKUP_OPERATION
             bool has_file = ss->lookupFile(f, wrench::FileLocation::LOCATION(ss));
@@ -104,48 +128,33 @@ void CacheComputation::determineFileSourcesAndCache(const std::shared_ptr<wrench
             bool has_file = SimpleSimulator::global_file_map[ss].hasFile(f);
 #endif
             if (has_file) {
-                source_ss = ss;
-                remote_data_size += f->getSize();
-                break;
+                replicas.push_back(ss);
+                // the first replica is all it takes with the default policy
+                if (SimpleSimulator::replica_selection == ReplicaSelectionPolicy::FirstReplica) break;
             }
         }
-        if (!source_ss) {
+        if (replicas.empty()) {
             throw std::runtime_error("CacheComputation(): Couldn't find file " + f->getID() + " on any storage service!");
         } else {
+            source_ss = ReplicaSelection::pick(SimpleSimulator::replica_selection, replicas, hostname, f);
+            remote_data_size += f->getSize();
             SimpleSimulator::global_file_map[source_ss].touchFile(f.get());
         }
 
-        // When there is a reachable cache, cache the file and evict others when needed
-        if (!matched_storage_services.empty()) {
-            // Destination storage to cache the file
-            // TODO: Find the optimal reachable cache destination, whatever that means (right now it's random, with a bad RNG!)
-            auto destination_ss = matched_storage_services.at(rand() % matched_storage_services.size());
-
-            // Evict files while to create space, using an LRU scheme!
-            auto free_space = destination_ss->getTotalFreeSpace();
-            while (free_space < f->getSize()) {
-                auto to_evict = SimpleSimulator::global_file_map[destination_ss].removeLRUFile();
-                WRENCH_INFO("Evicting file %s from storage service on host %s",
-                            to_evict->getID().c_str(), destination_ss->getHostname().c_str());
-                destination_ss->deleteFile(wrench::FileLocation::LOCATION(destination_ss, to_evict));
-                free_space += to_evict->getSize();
+        // When there are reachable caches, cache the file in each tier and evict others when needed.
+        // With block granularity, the blocks missed while reading are cached in the lowest tier.
+        bool admitted = !matched_storage_services.empty() &&
+                        CacheAdmission::admit(SimpleSimulator::cache_admission, f, this->workload_name);
+        if (block_granularity) {
+            if (cache_files && admitted) {
+                auto destination_ss = CachePlacement::pick(SimpleSimulator::cache_placement, matched_storage_services.begin()->second, f);
+                CachePlacement::addTransfer(destination_ss);
+                this->cache_transfers.push_back(destination_ss);
+                this->block_cache_destinations[f.get()] = destination_ss;
             }
-
-            // Instead of doing this file copy right here, instantly create the file locally for next jobs
-            if (cache_files) {
-                //? Alternative: Wait for computation to finish and copy file then
-                // TODO: Better idea perhaps: have the first job that streams the file update a counter
-                // TODO: of file blocks available at the storage service, and subsequent jobs
-                // TODO: can read a block only if it's available (e.g., by waiting on some
-                // TODO: condition variable, which is signaled by the first job each time it
-                // TODO: reads a block).
-                WRENCH_DEBUG("Caching file %s on storage %s", f->getID().c_str(), destination_ss->getHostname().c_str());
-                // wrench::StorageService::copyFile(f, wrench::FileLocation::LOCATION(source_ss), wrench::FileLocation::LOCATION(destination_ss));
-                wrench::StorageService::createFileAtLocation(wrench::FileLocation::LOCATION(destination_ss, f));
-
-                SimpleSimulator::global_file_map[destination_ss].touchFile(f.get());
-
-                // this->file_sources[f] = wrench::FileLocation::LOCATION(destination_ss);
+        } else {
+            for (auto const &tier: matched_storage_services) {
+                cacheFile(f, tier.second, admitted, cache_files);
             }
         }
 
@@ -163,6 +172,123 @@ void CacheComputation::determineFileSourcesAndCache(const std::shared_ptr<wrench
     the_action->set_hitrate(static_cast<double>(cached_data_size) / static_cast<double>(this->total_data_size));
 }
 
+/**
+ * @brief Cache a file missed in a tier on one of the tier's reachable caches,
+ * evicting other files according to the cache's eviction policy when space is needed
+ *
+ * @param f File to cache
+ * @param caches Reachable caches of the tier
+ * @param admitted Whether the admission policy lets the file into the cache or just accounts the miss
+ * @param cache_files Whether to cache files locally or only make space for them
+ */
+void CacheComputation::cacheFile(const std::shared_ptr<wrench::DataFile> &f,
+                                 const std::vector<std::shared_ptr<wrench::StorageService>> &caches,
+                                 const bool admitted, const bool cache_files) {
+    // Destination storage to cache the file
+    auto destination_ss = CachePlacement::pick(SimpleSimulator::cache_placement, caches, f);
+    CacheMonitor::recordMiss(destination_ss, f->getSize());
+    // Files not admitted don't displace others
+    if (!admitted) return;
+
+    // A cache full of files still being written can't take the file, which is then just read
+    if (!CacheComputation::freeSpace(destination_ss, f->getSize(), f->getID())) return;
+    if (!cache_files) return;
+
+    // Instead of doing this file copy right here, instantly create the file locally for next jobs.
+    // In the in-flight fill mode, this job writes the blocks it reads into the cache
+    // and subsequent jobs can read a block only once it's available.
+    CachePlacement::addTransfer(destination_ss);
+    this->cache_transfers.push_back(destination_ss);
+    if (SimpleSimulator::cache_fill_mode == CacheFillMode::InFlightFill) {
+        this->cache_fills_to_feed[f.get()].push_back(CacheFill::start(destination_ss, f));
+    } else if (SimpleSimulator::cache_write_queue > 0) {
+        // The file is available at once, but its bytes still have to be written
+        this->cache_writes_to_feed[f.get()].push_back(destination_ss);
+    }
+    WRENCH_DEBUG("Caching file %s on storage %s", f->getID().c_str(), destination_ss->getHostname().c_str());
+    // wrench::StorageService::copyFile(f, wrench::FileLocation::LOCATION(source_ss), wrench::FileLocation::LOCATION(destination_ss));
+    wrench::StorageService::createFileAtLocation(wrench::FileLocation::LOCATION(destination_ss, f));
+    CacheMonitor::recordAdmission(destination_ss, f->getSize());
+
+    SimpleSimulator::global_file_map[destination_ss].touchFile(f.get());
+}
+
+/**
+ * @brief Find the caches reachable from a host, which are the ones in the host's scope
+ * and those of upper tiers whose zone encloses the host, grouped by their tier
+ *
+ * @param hostname Host to reach the caches from
+ * @param caches All cache storage services
+ * @return reachable caches by tier, lowest tier first
+ */
+std::map<int, std::vector<std::shared_ptr<wrench::StorageService>>> CacheComputation::findReachableCaches(
+        const std::string &hostname, const std::set<std::shared_ptr<wrench::StorageService>> &caches) {
+    auto host = simgrid::s4u::Host::by_name(hostname);
+    std::string netzone = host->get_englobing_zone()->get_name();// network zone the host belongs to
+
+    std::map<int, std::vector<std::shared_ptr<wrench::StorageService>>> matched_storage_services;
+    for (auto const &ss: caches) {
+        bool host_in_scope = false;
+        if (SimpleSimulator::local_cache_scope) {
+            host_in_scope = (ss->getHostname() == hostname);
+        } else {
+            host_in_scope = (SimpleSimulator::hosts_in_zones[netzone].find(ss->getHostname()) != SimpleSimulator::hosts_in_zones[netzone].end());
+        }
+        int tier = SimpleSimulator::cache_tiers[ss->getHostname()];
+        if (!host_in_scope && SimpleSimulator::cache_tiers_on && tier > 0) {
+            // Caches of upper tiers also serve all zones nested in their own zone
+            std::string cache_zone = simgrid::s4u::Host::by_name(ss->getHostname())->get_englobing_zone()->get_name();
+            for (auto zone = host->get_englobing_zone(); zone && !host_in_scope; zone = zone->get_parent()) {
+                host_in_scope = (zone->get_name() == cache_zone);
+            }
+        }
+        if (host_in_scope) {
+            matched_storage_services[tier].push_back(ss);
+            WRENCH_DEBUG("Found a reachable cache of tier %d on host %s", tier, ss->getHostname().c_str());
+        }
+    }
+    return matched_storage_services;
+}
+
+/**
+ * @brief Evict files from a cache according to its eviction policy until there is space for a new file.
+ * Files still being written into the cache are kept.
+ *
+ * @param cache Cache to free space in
+ * @param num_bytes Space needed in bytes
+ * @param file_id ID of the file space is needed for
+ * @return whether there is enough space, false if all files left are still being written
+ */
+bool CacheComputation::freeSpace(const std::shared_ptr<wrench::StorageService> &cache, const sg_size_t num_bytes, const std::string &file_id) {
+    auto free_space = cache->getTotalFreeSpace();
+    while (free_space < num_bytes) {
+        auto to_evict = SimpleSimulator::global_file_map[cache].removeLRUFile([&cache](wrench::DataFile *file) {
+            return CacheFill::find(cache, file) != nullptr;
+        });
+        if (!to_evict) {
+            WRENCH_INFO("Couldn't free space for file %s in cache %s as all files are still being written",
+                        file_id.c_str(), cache->getHostname().c_str());
+            return false;
+        }
+        WRENCH_INFO("Evicting file %s from storage service on host %s",
+                    to_evict->getID().c_str(), cache->getHostname().c_str());
+        cache->deleteFile(wrench::FileLocation::LOCATION(cache, to_evict));
+        CacheMonitor::recordEviction(cache, to_evict->getSize());
+        DCSIM_PROFILE_COUNT(CacheEvictions, 1);
+        free_space += to_evict->getSize();
+    }
+    return true;
+}
+
+/**
+ * @brief Set the name of the workload the job belongs to, which admission policies may take into account
+ *
+ * @param name Workload name
+ */
+void CacheComputation::setWorkloadName(const std::string &name) {
+    this->workload_name = name;
+}
+
 //? Question for Henri: put this into determineFileSources function to prevent two times the same loop?
 /**
  * @brief Determine the incremental size of all input-files of a job
@@ -170,7 +296,7 @@ void CacheComputation::determineFileSourcesAndCache(const std::shared_ptr<wrench
  * @param files Input files of the job to consider
  * @return a data size
  */
-sg_size_t CacheComputation::determineTotalDataSize(const std::vector<std::shared_ptr<wrench::DataFile>> &files) const {
+sg_size_t CacheComputation::determineTotalDataSize(const FileRange &files) const {
     sg_size_t incr_file_size = 0;
     for (auto const &f: this->files) {
         incr_file_size += f->getSize();
@@ -191,7 +317,207 @@ void CacheComputation::operator()(const std::shared_ptr<wrench::ActionExecutor>
     this->determineFileSourcesAndCache(action_executor, SimpleSimulator::infile_caching_on);
     // Perform computation
     WRENCH_INFO("Performing the computation action");
-    this->performComputation(action_executor);
+    try {
+        this->performComputation(action_executor);
+    } catch (...) {
+        // Don't leave jobs waiting for cache fills this job won't finish
+        this->finishCacheFills();
+        throw;
+    }
+    this->finishCacheFills();
+    // With block granularity, the hitrate is known per byte only once all blocks have been read
+    if (SimpleSimulator::cache_granularity == CacheGranularity::BlockGranularity) {
+        auto the_action = std::dynamic_pointer_cast<MonitorAction>(action_executor->getAction());
+        WRENCH_DEBUG("Hitrate: %.2f (Cached data: %llu, total data: %llu)",
+            static_cast<double>(this->block_hit_bytes) / static_cast<double>(this->total_data_size),
+            this->block_hit_bytes, this->total_data_size);
+        the_action->set_hitrate(static_cast<double>(this->block_hit_bytes) / static_cast<double>(this->total_data_size));
+    }
+}
+
+/**
+ * @brief Read a range of bytes of an input-file from its source. With block granularity,
+ * blocks cached in a reachable cache are read from there instead.
+ *
+ * @param file Input-file to read
+ * @param location Location the file is read from
+ * @param offset Offset of the first byte to read
+ * @param num_bytes Number of bytes to read
+ */
+void CacheComputation::readFileRange(const std::shared_ptr<wrench::DataFile> &file,
+                                     const std::shared_ptr<wrench::FileLocation> &location,
+                                     const sg_size_t offset, const sg_size_t num_bytes) {
+    if (SimpleSimulator::cache_granularity == CacheGranularity::BlockGranularity) {
+        this->readFileBlocks(file, location, offset, num_bytes);
+        return;
+    }
+    double read_start = wrench::Simulation::getCurrentSimulatedDate();
+    location->getStorageService()->readFile(location, num_bytes);
+    NetworkMonitor::recordRead(location->getStorageService(), num_bytes, read_start);
+}
+
+/**
+ * @brief Read the blocks of an input-file covering a range of bytes. Blocks found in a reachable cache,
+ * walking the tiers in order, are read from the caches concurrently with the missing blocks
+ * from the file's source. Missing blocks are cached afterwards, evicting the blocks of
+ * the least recently used files when space is needed, unless they don't fit into the cache.
+ *
+ * @param file Input-file to read
+ * @param location Location the missing blocks are read from
+ * @param offset Offset of the first byte to read
+ * @param num_bytes Number of bytes to read
+ */
+void CacheComputation::readFileBlocks(const std::shared_ptr<wrench::DataFile> &file,
+                                      const std::shared_ptr<wrench::FileLocation> &location,
+                                      const sg_size_t offset, const sg_size_t num_bytes) {
+    size_t num_blocks = BlockCacheIndex::getNumBlocks(file);
+    if (num_bytes == 0 || offset >= file->getSize()) return;
+    auto first_block = static_cast<size_t>(offset / SimpleSimulator::xrd_block_size);
+    auto last_block = std::min(static_cast<size_t>((offset + num_bytes - 1) / SimpleSimulator::xrd_block_size), num_blocks - 1);
+
+    // Bytes to read from each cache holding blocks, in lookup order
+    std::vector<std::pair<std::shared_ptr<wrench::StorageService>, sg_size_t>> cached_bytes;
+    std::vector<size_t> missed_blocks;
+    sg_size_t missed_bytes = 0;
+    for (size_t block = first_block; block <= last_block; block++) {
+        DCSIM_PROFILE_COUNT(CacheLookups, 1);
+        auto block_size = BlockCacheIndex::getBlockSize(file, block);
+        auto cache = std::find_if(this->block_caches.begin(), this->block_caches.end(), [&file, block](const std::shared_ptr<wrench::StorageService> &ss) {
+            return BlockCacheIndex::get(ss).hasBlock(file, block);
+        });
+        if (cache == this->block_caches.end()) {
+            missed_blocks.push_back(block);
+            missed_bytes += block_size;
+            continue;
+        }
+        auto bytes = std::find_if(cached_bytes.begin(), cached_bytes.end(), [&cache](const auto &entry) { return entry.first == *cache; });
+        if (bytes == cached_bytes.end()) {
+            cached_bytes.emplace_back(*cache, block_size);
+        } else {
+            bytes->second += block_size;
+        }
+    }
+
+    // Read the cached blocks alongside the missing ones
+    std::vector<std::shared_ptr<AsyncRead>> cache_reads;
+    for (auto const &[cache, bytes]: cached_bytes) {
+        WRENCH_DEBUG("Found %llu bytes of file %s in cache %s", bytes, file->getID().c_str(), cache->getHostname().c_str());
+        cache_reads.push_back(std::make_shared<AsyncRead>(wrench::FileLocation::LOCATION(cache, file), bytes));
+        BlockCacheIndex::get(cache).touchFile(file);
+        CacheMonitor::recordHit(cache, bytes);
+        this->block_hit_bytes += bytes;
+    }
+    if (missed_bytes > 0) {
+        double read_start = wrench::Simulation::getCurrentSimulatedDate();
+        location->getStorageService()->readFile(location, missed_bytes);
+        NetworkMonitor::recordRead(location->getStorageService(), missed_bytes, read_start);
+    }
+    for (auto const &read: cache_reads) {
+        read->wait();
+    }
+
+    auto destination = this->block_cache_destinations.find(file.get());
+    if (missed_blocks.empty() || destination == this->block_cache_destinations.end()) return;
+    auto destination_ss = destination->second;
+    auto &index = BlockCacheIndex::get(destination_ss);
+    CacheMonitor::recordMiss(destination_ss, missed_bytes);
+    // Blocks that don't fit into the cache are just read from the source
+    if (missed_bytes > destination_ss->getTotalSpace()) {
+        WRENCH_DEBUG("Blocks of file %s exceed the size of cache %s, not caching them", file->getID().c_str(), destination_ss->getHostname().c_str());
+        return;
+    }
+    while (destination_ss->getTotalSpace() - index.getUsedSpace() < missed_bytes) {
+        sg_size_t freed = index.removeLRUFile();
+        if (freed == 0) {
+            WRENCH_INFO("Couldn't free space for blocks of file %s in cache %s, not caching them",
+                        file->getID().c_str(), destination_ss->getHostname().c_str());
+            return;
+        }
+        WRENCH_INFO("Evicting %llu bytes of blocks from storage service on host %s", freed, destination_ss->getHostname().c_str());
+        CacheMonitor::recordEviction(destination_ss, freed);
+        DCSIM_PROFILE_COUNT(CacheEvictions, 1);
+    }
+    for (auto block: missed_blocks) {
+        index.addBlock(file, block);
+    }
+    CacheMonitor::recordAdmission(destination_ss, missed_bytes);
+    // Without a writer queue the reading job writes the blocks itself, like in-flight fills of whole files
+    if (SimpleSimulator::cache_write_queue > 0) {
+        CacheWriter::write(destination_ss, missed_bytes, nullptr);
+    } else {
+        CacheWriter::writeNow(destination_ss, simgrid::s4u::this_actor::get_host(), missed_bytes);
+    }
+}
+
+/**
+ * @brief Wait until the first bytes of a file read from a cache are available,
+ * in case the file is still being written into the cache by another job
+ *
+ * @param file Input-file to read
+ * @param num_bytes Number of bytes from the start of the file needed
+ */
+void CacheComputation::awaitCachedBytes(const std::shared_ptr<wrench::DataFile> &file, const sg_size_t num_bytes) {
+    auto fill = this->cache_fills_to_await.find(file.get());
+    if (fill == this->cache_fills_to_await.end()) return;
+    fill->second->waitForBytes(num_bytes);
+}
+
+/**
+ * @brief Write bytes of a file read into the caches this job fills with it
+ *
+ * @param file Input-file read
+ * @param num_bytes Number of bytes read
+ */
+void CacheComputation::feedCachedBytes(const std::shared_ptr<wrench::DataFile> &file, sg_size_t num_bytes) {
+    // A file listed twice by the job is written into the caches only once
+    auto &bytes_fed = this->cache_bytes_fed[file.get()];
+    num_bytes = std::min<sg_size_t>(num_bytes, file->getSize() - bytes_fed);
+    if (num_bytes == 0) return;
+    bytes_fed += num_bytes;
+    auto writes = this->cache_writes_to_feed.find(file.get());
+    if (writes != this->cache_writes_to_feed.end()) {
+        for (auto const &cache: writes->second) {
+            CacheWriter::write(cache, num_bytes, nullptr);
+        }
+    }
+    auto fills = this->cache_fills_to_feed.find(file.get());
+    if (fills == this->cache_fills_to_feed.end()) return;
+    for (auto const &fill: fills->second) {
+        fill->addBytes(num_bytes);
+    }
+}
+
+/**
+ * @brief Feed the throughput observed on a read from a GRID storage into the replica selection.
+ * Reads from caches are ignored.
+ *
+ * @param location Location read from
+ * @param num_bytes Number of bytes read
+ * @param duration Duration of the read
+ */
+void CacheComputation::recordReadThroughput(const std::shared_ptr<wrench::FileLocation> &location, const sg_size_t num_bytes, const double duration) {
+    if (SimpleSimulator::replica_selection != ReplicaSelectionPolicy::ThroughputReplica) return;
+    if (this->grid_storage_services.find(location->getStorageService()) == this->grid_storage_services.end()) return;
+    ReplicaSelection::recordThroughput(simgrid::s4u::this_actor::get_host()->get_name(), location->getStorageService(), num_bytes, duration);
+}
+
+/**
+ * @brief Mark all cache fills of this job as done and release the caches it used
+ */
+void CacheComputation::finishCacheFills() {
+    for (auto const &fills: this->cache_fills_to_feed) {
+        for (auto const &fill: fills.second) {
+            fill->finish();
+        }
+    }
+    this->cache_fills_to_feed.clear();
+    this->cache_fills_to_await.clear();
+    this->cache_writes_to_feed.clear();
+    this->cache_bytes_fed.clear();
+    for (auto const &cache: this->cache_transfers) {
+        CachePlacement::removeTransfer(cache);
+    }
+    this->cache_transfers.clear();
 }
 
 /**
@@ -207,6 +533,36 @@ double CacheComputation::determineFlops(const sg_size_t data_size, const sg_size
     return flops;
 }
 
+/**
+ * @brief Set the CPU scaling model of the job and the number of cores it runs on.
+ * Without a configured model the computation runs single-threaded, whatever the cores of the job.
+ *
+ * @param scaling CPU scaling model of the workload
+ * @param cores Number of cores of the job
+ */
+void CacheComputation::setCpuScaling(const CpuScaling &scaling, const unsigned long cores) {
+    if (!scaling.isConfigured()) {
+        this->num_threads = 1;
+        this->speedup = 1.;
+        return;
+    }
+    this->num_threads = std::max<unsigned long>(cores, 1);
+    this->speedup = scaling.getSpeedup(this->num_threads);
+}
+
+/**
+ * @brief Create a computation on all cores of the job, whose flops are inflated
+ * so that it takes as long as the flops take with the job's speedup
+ *
+ * @param flops Number of flops on a single core at full efficiency
+ * @return the computation, not yet started
+ */
+simgrid::s4u::ExecPtr CacheComputation::initExec(const double flops) const {
+    auto exec = simgrid::s4u::this_actor::exec_init(flops * static_cast<double>(this->num_threads) / this->speedup);
+    exec->set_thread_count(static_cast<int>(this->num_threads));
+    return exec;
+}
+
 /**
  * @brief Perform the computation within the simulation of the job
  * 
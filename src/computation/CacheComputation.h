@@ -6,6 +6,9 @@
 #include <wrench-dev.h>
 
 #include "../SimpleSimulator.h"
+#include "../CacheFill.h"
+#include "../FileRange.h"
+#include "CpuScaling.h"
 
 class CacheComputation {
 
@@ -13,7 +16,7 @@ public:
     CacheComputation(
             const std::set<std::shared_ptr<wrench::StorageService>> &cache_storage_services,
             const std::set<std::shared_ptr<wrench::StorageService>> &grid_storage_services,
-            const std::vector<std::shared_ptr<wrench::DataFile>> &files,
+            const FileRange &files,
             double total_flops);
 
     virtual ~CacheComputation() = default;
@@ -26,17 +29,62 @@ public:
 
     virtual void performComputation(const std::shared_ptr<wrench::ActionExecutor> &action_executor);
 
+    void setWorkloadName(const std::string &name);
+
+    void setCpuScaling(const CpuScaling &scaling, unsigned long cores);
+
+    static std::map<int, std::vector<std::shared_ptr<wrench::StorageService>>> findReachableCaches(
+            const std::string &hostname, const std::set<std::shared_ptr<wrench::StorageService>> &caches);
+
+    static bool freeSpace(const std::shared_ptr<wrench::StorageService> &cache, sg_size_t num_bytes, const std::string &file_id);
+
 protected:
     std::set<std::shared_ptr<wrench::StorageService>> cache_storage_services;
     std::set<std::shared_ptr<wrench::StorageService>> grid_storage_services;
-    std::vector<std::shared_ptr<wrench::DataFile>> files;//? does this need to be ordered?
+    FileRange files;//? does this need to be ordered?
     double total_flops;
+    std::string workload_name;
+    // cores the computation runs on and its speedup over a single core
+    unsigned long num_threads = 1;
+    double speedup = 1.;
 
     std::vector<std::pair<std::shared_ptr<wrench::DataFile>, std::shared_ptr<wrench::FileLocation>>> file_sources;
     double total_flops_;
 
-    sg_size_t determineTotalDataSize(const std::vector<std::shared_ptr<wrench::DataFile>> &files) const;
+    sg_size_t determineTotalDataSize(const FileRange &files) const;
     sg_size_t total_data_size;
+
+    // fills of caches this job feeds with the files it reads
+    std::map<wrench::DataFile *, std::vector<std::shared_ptr<CacheFill>>> cache_fills_to_feed;
+    // fills of caches this job waits for when reading files from a cache
+    std::map<wrench::DataFile *, std::shared_ptr<CacheFill>> cache_fills_to_await;
+    // caches this job writes the files it reads into, which are available there at once
+    std::map<wrench::DataFile *, std::vector<std::shared_ptr<wrench::StorageService>>> cache_writes_to_feed;
+    // bytes of the files read so far, which are fed into the caches once per file
+    std::map<wrench::DataFile *, sg_size_t> cache_bytes_fed;
+
+    // caches this job reads from or fills, accounted as their load
+    std::vector<std::shared_ptr<wrench::StorageService>> cache_transfers;
+
+    // reachable caches in lookup order, in which blocks are looked up with block granularity
+    std::vector<std::shared_ptr<wrench::StorageService>> block_caches;
+    // caches the blocks of a file missed with block granularity are written to
+    std::map<wrench::DataFile *, std::shared_ptr<wrench::StorageService>> block_cache_destinations;
+    // bytes read from caches with block granularity
+    sg_size_t block_hit_bytes = 0;
+
+    void cacheFile(const std::shared_ptr<wrench::DataFile> &f,
+                   const std::vector<std::shared_ptr<wrench::StorageService>> &caches,
+                   bool admitted, bool cache_files);
+    void awaitCachedBytes(const std::shared_ptr<wrench::DataFile> &file, sg_size_t num_bytes);
+    void feedCachedBytes(const std::shared_ptr<wrench::DataFile> &file, sg_size_t num_bytes);
+    void finishCacheFills();
+    void readFileRange(const std::shared_ptr<wrench::DataFile> &file, const std::shared_ptr<wrench::FileLocation> &location,
+                       sg_size_t offset, sg_size_t num_bytes);
+    void readFileBlocks(const std::shared_ptr<wrench::DataFile> &file, const std::shared_ptr<wrench::FileLocation> &location,
+                        sg_size_t offset, sg_size_t num_bytes);
+    simgrid::s4u::ExecPtr initExec(double flops) const;
+    void recordReadThroughput(const std::shared_ptr<wrench::FileLocation> &location, sg_size_t num_bytes, double duration);
 };
 
 #endif//S_CACHECOMPUTATION_H
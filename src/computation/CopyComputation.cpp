@@ -4,11 +4,12 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(copy_computation, "Log category for CopyComputation
 
 #include "CopyComputation.h"
 #include "MonitorAction.h"
+#include "AsyncRead.h"
 
 /**
  * @brief Construct a new CopyComputation::CopyComputation object
  * to be used as a lambda within a compute action, which shall take caching of input-files into account.
- * File read of all input-files and compute steps are performed sequentially.
+ * All input-files are read before the computation, up to SimpleSimulator::copy_concurrency of them at a time.
  * 
  * @param cache_storage_services Storage services reachable to retrieve input files (caches)
  * @param grid_storage_services Storage services reachable to retrieve input files (remote)
@@ -18,7 +19,7 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(copy_computation, "Log category for CopyComputation
 CopyComputation::CopyComputation(
         const std::set<std::shared_ptr<wrench::StorageService>> &cache_storage_services,
         const std::set<std::shared_ptr<wrench::StorageService>> &grid_storage_services,
-        const std::vector<std::shared_ptr<wrench::DataFile>> &files,
+        const FileRange &files,
         const double total_flops) : CacheComputation::CacheComputation(cache_storage_services,
                                                                  grid_storage_services,
                                                                  files,
@@ -42,20 +43,50 @@ void CopyComputation::performComputation(const std::shared_ptr<wrench::ActionExe
     sg_size_t total_data_size = this->total_data_size;
     // Read all input files before computation
     sg_size_t data_size = 0;
-    for (auto const &fs: this->file_sources) {
-        WRENCH_INFO("Reading file %s from storage service on host %s",
-                    fs.first->getID().c_str(), fs.second->getStorageService()->getHostname().c_str());
+    if (SimpleSimulator::copy_concurrency > 1 && SimpleSimulator::cache_granularity == CacheGranularity::FileGranularity) {
+        // Keep up to copy_concurrency files in flight, starting the next one whenever a read completes
+        std::vector<std::shared_ptr<AsyncRead>> outstanding_reads;
+        std::vector<std::shared_ptr<AsyncRead>> completed_reads;
+        auto next_source = this->file_sources.begin();
+        while (next_source != this->file_sources.end() || !outstanding_reads.empty()) {
+            while (next_source != this->file_sources.end() && outstanding_reads.size() < SimpleSimulator::copy_concurrency) {
+                WRENCH_INFO("Reading file %s from storage service on host %s",
+                            next_source->first->getID().c_str(), next_source->second->getStorageService()->getHostname().c_str());
+                awaitCachedBytes(next_source->first, next_source->first->getSize());
+                outstanding_reads.push_back(std::make_shared<AsyncRead>(next_source->second, next_source->first->getSize()));
+                ++next_source;
+            }
+            auto read = AsyncRead::waitAny(outstanding_reads);
+            if (read->getEndTime() < read->getStartTime()) {
+                throw std::runtime_error(
+                        "Reading file " + read->getLocation()->getFile()->getID() + " finished before it started!");
+            }
+            feedCachedBytes(read->getLocation()->getFile(), read->getNumBytes());
+            recordReadThroughput(read->getLocation(), read->getNumBytes(), read->getEndTime() - read->getStartTime());
+            data_size += read->getNumBytes();
+            completed_reads.push_back(read);
+        }
+        // Overlapping transfers are accounted once
+        infile_transfer_time += AsyncRead::getBusyTime(completed_reads);
+    } else {
+        for (auto const &fs: this->file_sources) {
+            WRENCH_INFO("Reading file %s from storage service on host %s",
+                        fs.first->getID().c_str(), fs.second->getStorageService()->getHostname().c_str());
 
-        double read_start_time = wrench::Simulation::getCurrentSimulatedDate();
-        fs.second->getStorageService()->readFile(fs.second);
-        double read_end_time = wrench::Simulation::getCurrentSimulatedDate();
+            awaitCachedBytes(fs.first, fs.first->getSize());
+            double read_start_time = wrench::Simulation::getCurrentSimulatedDate();
+            readFileRange(fs.first, fs.second, 0, fs.first->getSize());
+            double read_end_time = wrench::Simulation::getCurrentSimulatedDate();
+            recordReadThroughput(fs.second, fs.first->getSize(), read_end_time - read_start_time);
+            feedCachedBytes(fs.first, fs.first->getSize());
 
-        data_size += fs.first->getSize();
-        if (read_end_time >= read_start_time) {
-            infile_transfer_time += read_end_time - read_start_time;
-        } else {
-            throw std::runtime_error(
-                    "Reading file " + fs.first->getID() + " finished before it started!");
+            data_size += fs.first->getSize();
+            if (read_end_time >= read_start_time) {
+                infile_transfer_time += read_end_time - read_start_time;
+            } else {
+                throw std::runtime_error(
+                        "Reading file " + fs.first->getID() + " finished before it started!");
+            }
         }
     }
     if (data_size != total_data_size) {
@@ -66,7 +97,9 @@ void CopyComputation::performComputation(const std::shared_ptr<wrench::ActionExe
     double flops = determineFlops(data_size, total_data_size);
     WRENCH_INFO("Computing %.2lf flops", flops);
     double compute_start_time = wrench::Simulation::getCurrentSimulatedDate();
-    wrench::Simulation::compute(flops);
+    auto exec = this->initExec(flops);
+    exec->start();
+    exec->wait();
     double compute_end_time = wrench::Simulation::getCurrentSimulatedDate();
 
     if (compute_end_time > compute_start_time) {
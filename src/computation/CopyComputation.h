@@ -13,7 +13,7 @@ public:
     CopyComputation(
             const std::set<std::shared_ptr<wrench::StorageService>> &cache_storage_services,
             const std::set<std::shared_ptr<wrench::StorageService>> &grid_storage_services,
-            const std::vector<std::shared_ptr<wrench::DataFile>> &files,
+            const FileRange &files,
             double total_flops);
 
     void performComputation(const std::shared_ptr<wrench::ActionExecutor> &action_executor) override;
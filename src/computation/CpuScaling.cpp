@@ -0,0 +1,108 @@
+#include "CpuScaling.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+/**
+ * @brief Create a CPU scaling model from its JSON description, e.g.
+ * {"type": "amdahl", "serial_fraction": 0.05}, {"type": "efficiency", "efficiency": 0.9} or
+ * {"type": "table", "cores": [1, 2, 4, 8], "speedup": [1, 1.9, 3.5, 6.2]}.
+ * Without a description jobs speed up ideally with their cores.
+ *
+ * @param config JSON object containing the type and parameters of the model
+ *
+ * @throw std::runtime_error
+ */
+CpuScaling::CpuScaling(const nlohmann::json &config) {
+    this->config = config;
+    if (config.is_null() || config.empty()) {
+        return;
+    }
+    std::string type = config.value("type", "efficiency");
+    if (type == "efficiency") {
+        this->type = CpuScalingType::ConstantEfficiencyScaling;
+        this->efficiency = config.value("efficiency", 1.);
+        if (this->efficiency <= 0.) {
+            throw std::runtime_error("Constant efficiency CPU scaling needs a positive efficiency!");
+        }
+    } else if (type == "amdahl") {
+        this->type = CpuScalingType::AmdahlScaling;
+        this->serial_fraction = config.value("serial_fraction", 0.);
+        if (this->serial_fraction < 0. || this->serial_fraction > 1.) {
+            throw std::runtime_error("Amdahl CPU scaling needs a serial fraction between 0 and 1!");
+        }
+    } else if (type == "table") {
+        this->type = CpuScalingType::SpeedupTableScaling;
+        if (!config.contains("cores") || !config.contains("speedup")) {
+            throw std::runtime_error("Speedup table CPU scaling needs cores and speedup lists!");
+        }
+        this->table_cores = config["cores"].get<std::vector<double>>();
+        this->table_speedups = config["speedup"].get<std::vector<double>>();
+        if (this->table_cores.empty() || this->table_cores.size() != this->table_speedups.size()) {
+            throw std::runtime_error("Speedup table CPU scaling needs as many speedups as numbers of cores!");
+        }
+        for (size_t i = 0; i < this->table_cores.size(); i++) {
+            if (this->table_cores[i] < 1. || (i > 0 && this->table_cores[i] <= this->table_cores[i - 1])) {
+                throw std::runtime_error("Speedup table CPU scaling needs ascending numbers of cores of at least 1!");
+            }
+            if (this->table_speedups[i] <= 0.) {
+                throw std::runtime_error("Speedup table CPU scaling needs positive speedups!");
+            }
+        }
+    } else {
+        throw std::runtime_error("CPU scaling " + type + " invalid. Please choose 'efficiency', 'amdahl', or 'table'");
+    }
+}
+
+/**
+ * @brief Speedup of a job running on a number of cores over running on a single core at full efficiency.
+ * Tables are interpolated linearly, scale proportionally below their first entry and stay flat beyond their last.
+ *
+ * @param cores Number of cores
+ * @return the speedup
+ */
+double CpuScaling::getSpeedup(const unsigned long cores) const {
+    auto n = static_cast<double>(std::max<unsigned long>(cores, 1));
+    switch (this->type) {
+        case CpuScalingType::ConstantEfficiencyScaling:
+            return this->efficiency * n;
+        case CpuScalingType::AmdahlScaling:
+            return 1. / (this->serial_fraction + (1. - this->serial_fraction) / n);
+        case CpuScalingType::SpeedupTableScaling: {
+            if (n <= this->table_cores.front()) {
+                return this->table_speedups.front() * n / this->table_cores.front();
+            }
+            if (n >= this->table_cores.back()) {
+                return this->table_speedups.back();
+            }
+            size_t i = std::upper_bound(this->table_cores.begin(), this->table_cores.end(), n) - this->table_cores.begin();
+            double weight = (n - this->table_cores[i - 1]) / (this->table_cores[i] - this->table_cores[i - 1]);
+            return this->table_speedups[i - 1] + weight * (this->table_speedups[i] - this->table_speedups[i - 1]);
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief WRENCH parallel model of compute actions following this model
+ *
+ * @return the parallel model
+ */
+std::shared_ptr<wrench::ParallelModel> CpuScaling::getParallelModel() const {
+    switch (this->type) {
+        case CpuScalingType::ConstantEfficiencyScaling:
+            return wrench::ParallelModel::CONSTANTEFFICIENCY(this->efficiency);
+        case CpuScalingType::AmdahlScaling:
+            // WRENCH parametrizes Amdahl's law by the parallelizable fraction
+            return wrench::ParallelModel::AMDAHL(1. - this->serial_fraction);
+        case CpuScalingType::SpeedupTableScaling:
+            break;
+    }
+    auto scaling = *this;
+    return wrench::ParallelModel::CUSTOM(
+            [](double work, long num_threads) { return 0.; },
+            [scaling](double work, long num_threads) {
+                return work / scaling.getSpeedup(static_cast<unsigned long>(num_threads));
+            });
+}
@@ -0,0 +1,55 @@
+#ifndef S_CPUSCALING_H
+#define S_CPUSCALING_H
+
+#include <memory>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <wrench-dev.h>
+
+/**
+ * @brief Models of how the computation of a job speeds up with the number of cores it runs on
+ */
+enum CpuScalingType {
+    // speedup proportional to the cores, each core contributing a constant efficiency
+    ConstantEfficiencyScaling,
+    // Amdahl's law, a fixed fraction of the work being serial
+    AmdahlScaling,
+    // speedups measured for some numbers of cores, interpolated linearly in between
+    SpeedupTableScaling
+};
+
+/**
+ * @brief CPU scaling model of a workload, which determines the speedup of its jobs from their number of cores.
+ * Calculations are handed the model as WRENCH parallel model, while streaming and copy jobs
+ * configured with a model run their computations on all their cores with the flops inflated by the lost efficiency.
+ */
+class CpuScaling {
+
+public:
+    CpuScaling() = default;
+    explicit CpuScaling(const nlohmann::json &config);
+
+    double getSpeedup(unsigned long cores) const;
+
+    std::shared_ptr<wrench::ParallelModel> getParallelModel() const;
+
+    /** @brief whether the model was created from a description rather than defaulted */
+    bool isConfigured() const { return !this->config.is_null() && !this->config.empty(); }
+
+    /** @brief JSON description the model was created from */
+    const nlohmann::json &getConfig() const { return this->config; }
+
+private:
+    CpuScalingType type = CpuScalingType::ConstantEfficiencyScaling;
+    nlohmann::json config;
+    // efficiency per core of the constant efficiency model
+    double efficiency = 1.;
+    // serial fraction of the work in Amdahl's law
+    double serial_fraction = 0.;
+    // measured speedups by ascending number of cores
+    std::vector<double> table_cores;
+    std::vector<double> table_speedups;
+};
+
+#endif//S_CPUSCALING_H
@@ -4,6 +4,10 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(streamed_computation, "Log category for StreamedCom
 
 #include "StreamedComputation.h"
 #include "MonitorAction.h"
+#include "AsyncRead.h"
+#include "monitoring/Profiler.h"
+
+#include <deque>
 
 
 /**
@@ -21,7 +25,7 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(streamed_computation, "Log category for StreamedCom
 StreamedComputation::StreamedComputation(
         std::set<std::shared_ptr<wrench::StorageService>> &cache_storage_services,
         const std::set<std::shared_ptr<wrench::StorageService>> &grid_storage_services,
-        const std::vector<std::shared_ptr<wrench::DataFile>> &files,
+        const FileRange &files,
         const double total_flops, const bool prefetch_on) : CacheComputation::CacheComputation(cache_storage_services,
                                                                                    grid_storage_services,
                                                                                    files,
@@ -49,14 +53,25 @@ void StreamedComputation::performComputation(const std::shared_ptr<wrench::Actio
         WRENCH_INFO("Streaming computation for input file %s in location %s", fs.first->getID().c_str(), fs.second->getStorageService()->getHostname().c_str());
         sg_size_t data_to_process = fs.first->getSize();
 
+        if (SimpleSimulator::xrd_readahead > 0 && this->prefetching_on &&
+            SimpleSimulator::xrd_streaming_mode == StreamingMode::BlockStreaming &&
+            SimpleSimulator::cache_granularity == CacheGranularity::FileGranularity) {
+            streamWithReadahead(fs.first, fs.second, file_local, total_data_size, the_action, infile_transfer_time, compute_time);
+            continue;
+        }
+
         // Compute the number of blocks
         auto num_blocks = static_cast<int>(std::ceil(static_cast<double>(data_to_process) / static_cast<double>(SimpleSimulator::xrd_block_size)));
 
         // Read the first block
         double xrd_block_start_time;
+        sg_size_t bytes_streamed = std::min<sg_size_t>(SimpleSimulator::xrd_block_size, data_to_process);
+        awaitCachedBytes(fs.first, bytes_streamed);
         double read_start_time = wrench::Simulation::getCurrentSimulatedDate();
-        fs.second->getStorageService()->readFile(fs.second, std::min<sg_size_t>(SimpleSimulator::xrd_block_size, data_to_process));
+        readFileRange(fs.first, fs.second, 0, bytes_streamed);
         double read_end_time = wrench::Simulation::getCurrentSimulatedDate();
+        recordReadThroughput(fs.second, bytes_streamed, read_end_time - read_start_time);
+        feedCachedBytes(fs.first, bytes_streamed);
         if (read_end_time > read_start_time) {
             infile_transfer_time += read_end_time - read_start_time;
             xrd_block_start_time = read_start_time;
@@ -67,8 +82,85 @@ void StreamedComputation::performComputation(const std::shared_ptr<wrench::Actio
                     " of file " + fs.first->getID() + " finished before it started!");
         }
 
+        int first_pipelined_block = 0;
+        // XRootD overhead flops per second of streaming and the rate the job computes at
+        double xrd_flops_per_time = file_local ? SimpleSimulator::xrd_add_flops_local_per_time : SimpleSimulator::xrd_add_flops_per_time;
+        double flop_rate = simgrid::s4u::Host::current()->get_speed() * this->speedup;
+        if (SimpleSimulator::xrd_streaming_mode == StreamingMode::FluidStreaming && num_blocks > 1 && this->prefetching_on && xrd_flops_per_time >= flop_rate) {
+            // The overhead of every pre-fetched block outgrows its computation, which only the block engine can follow
+            WRENCH_INFO("XRootD overhead exceeds the flop rate, streaming file %s block by block", fs.first->getID().c_str());
+        } else if (SimpleSimulator::xrd_streaming_mode == StreamingMode::FluidStreaming && num_blocks > 1) {
+            // Coalesce the pipelined stages of blocks 0 to num_blocks-2 into a single compute
+            // running alongside a single read of the remaining file. With uniform blocks the stage
+            // takes the time of the bottleneck, as the sum of the per-block maxima does.
+            double first_read_time = read_end_time - read_start_time;
+            auto num_bytes = static_cast<sg_size_t>(num_blocks - 1) * SimpleSimulator::xrd_block_size;
+            auto read_bytes = data_to_process - std::min<sg_size_t>(SimpleSimulator::xrd_block_size, data_to_process);
+            double num_flops = determineFlops(num_bytes, total_data_size);
+            if (this->prefetching_on) {
+                // Each block is charged the overhead for the stage before it, which in a compute-bound stream
+                // lengthens the stage and thereby the next overhead. The steady state of this growth is the
+                // computation running at the flop rate reduced by the overhead rate.
+                double xrd_overhead_flops = num_flops * xrd_flops_per_time / (flop_rate - xrd_flops_per_time);
+                num_flops += xrd_overhead_flops;
+                WRENCH_DEBUG("       + %.2lf flops XRootD overhead", xrd_overhead_flops);
+            }
+            WRENCH_INFO("Coalesced chunk: %llu bytes / %.2lf flops", num_bytes, num_flops);
+            simgrid::s4u::ExecPtr exec = this->initExec(num_flops);
+            DCSIM_PROFILE_COUNT(StreamedBlocks, 1);
+            exec->start();
+            double exec_start_time = exec->get_start_time();
+            if (!this->prefetching_on) {
+                exec->wait();
+            }
+            awaitCachedBytes(fs.first, fs.first->getSize());
+            read_start_time = wrench::Simulation::getCurrentSimulatedDate();
+            readFileRange(fs.first, fs.second, bytes_streamed, read_bytes);
+            recordReadThroughput(fs.second, read_bytes, wrench::Simulation::getCurrentSimulatedDate() - read_start_time);
+            feedCachedBytes(fs.first, read_bytes);
+            // The block engine issues a request per block, each waiting for the round trip to the storage
+            double request_latency = 0.;
+            std::vector<simgrid::s4u::Link *> links;
+            simgrid::s4u::Host::by_name(fs.second->getStorageService()->getHostname())->route_to(simgrid::s4u::Host::current(), links, &request_latency);
+            wrench::Simulation::sleep(static_cast<double>(num_blocks - 2) * 2. * request_latency);
+            read_end_time = wrench::Simulation::getCurrentSimulatedDate();
+            double block_stage_time;
+            if (this->prefetching_on) {
+                exec->wait();
+                block_stage_time = (std::max(exec->get_finish_time(), read_end_time) - exec_start_time) / static_cast<double>(num_blocks - 1);
+            } else {
+                // Without pre-fetching each block is charged the overhead for its own read
+                block_stage_time = (read_end_time - read_start_time) / static_cast<double>(num_blocks - 1);
+                double xrd_overhead_flops = xrd_flops_per_time * (first_read_time + read_end_time - read_start_time - block_stage_time);
+                WRENCH_DEBUG("       + %.2lf flops XRootD overhead", xrd_overhead_flops);
+                auto overhead_exec = this->initExec(xrd_overhead_flops);
+                overhead_exec->start();
+                overhead_exec->wait();
+                compute_time += overhead_exec->get_finish_time() - overhead_exec->get_start_time();
+            }
+            double exec_end_time = exec->get_finish_time();
+            data_to_process -= num_bytes;
+            if (exec_end_time >= exec_start_time) {
+                compute_time += exec_end_time - exec_start_time;
+                WRENCH_INFO("Streaming computation completed blocks 0 to %d of file %s", num_blocks - 2, the_action->getJob()->getName().c_str());
+            } else {
+                throw std::runtime_error(
+                        "Executing coalesced blocks of job " + the_action->getJob()->getName() + " finished before it started!");
+            }
+            if (read_end_time > read_start_time) {
+                infile_transfer_time += read_end_time - read_start_time;
+                // The last block is charged the overhead for a single stage
+                xrd_block_start_time = wrench::Simulation::getCurrentSimulatedDate() - block_stage_time;
+                WRENCH_INFO("Streaming computation received blocks 1 to %d of file %s", num_blocks - 1, fs.first->getID().c_str());
+            } else {
+                throw std::runtime_error(
+                        "Reading coalesced blocks of file " + fs.first->getID() + " finished before it started!");
+            }
+            first_pipelined_block = num_blocks - 1;
+        }
+
         // Process next blocks: compute block i while reading block i+i
-        for (int i = 0; i < num_blocks - 1; i++) {
+        for (int i = first_pipelined_block; i < num_blocks - 1; i++) {
             auto num_bytes = std::min<sg_size_t>(SimpleSimulator::xrd_block_size, data_to_process);
             double num_flops = determineFlops(num_bytes, total_data_size);
             WRENCH_INFO("Chunk: %llu bytes / %.2lf flops", num_bytes, num_flops);
@@ -82,16 +174,21 @@ void StreamedComputation::performComputation(const std::shared_ptr<wrench::Actio
             num_flops += xrd_overhead_flops;
             WRENCH_DEBUG("       + %.2lf flops XRootD overhead", xrd_overhead_flops);
             // Start the computation asynchronously
-            simgrid::s4u::ExecPtr exec = simgrid::s4u::this_actor::exec_init(num_flops);
+            simgrid::s4u::ExecPtr exec = this->initExec(num_flops);
+            DCSIM_PROFILE_COUNT(StreamedBlocks, 1);
             double exec_start_time = 0.0;
             double exec_end_time = 0.0;
             if (this->prefetching_on) {
                 exec->start();
                 exec_start_time = exec->get_start_time();
                 // Read data from the file
+                awaitCachedBytes(fs.first, bytes_streamed + num_bytes);
                 read_start_time = wrench::Simulation::getCurrentSimulatedDate();
-                fs.second->getStorageService()->readFile(fs.second, num_bytes);
+                readFileRange(fs.first, fs.second, bytes_streamed, num_bytes);
                 read_end_time = wrench::Simulation::getCurrentSimulatedDate();
+                recordReadThroughput(fs.second, num_bytes, read_end_time - read_start_time);
+                feedCachedBytes(fs.first, num_bytes);
+                bytes_streamed += num_bytes;
                 // Wait for the computation to be done
                 exec->wait();
                 exec_end_time = exec->get_finish_time();
@@ -100,9 +197,13 @@ void StreamedComputation::performComputation(const std::shared_ptr<wrench::Actio
                 exec_start_time = exec->get_start_time();
                 exec->wait();
                 exec_end_time = exec->get_finish_time();
+                awaitCachedBytes(fs.first, bytes_streamed + num_bytes);
                 read_start_time = wrench::Simulation::getCurrentSimulatedDate();
-                fs.second->getStorageService()->readFile(fs.second, num_bytes);
+                readFileRange(fs.first, fs.second, bytes_streamed, num_bytes);
                 read_end_time = wrench::Simulation::getCurrentSimulatedDate();
+                recordReadThroughput(fs.second, num_bytes, read_end_time - read_start_time);
+                feedCachedBytes(fs.first, num_bytes);
+                bytes_streamed += num_bytes;
             }
             data_to_process -= num_bytes;
             if (exec_end_time >= exec_start_time) {
@@ -137,7 +238,8 @@ void StreamedComputation::performComputation(const std::shared_ptr<wrench::Actio
         }
         num_flops += xrd_overhead_flops;
         WRENCH_DEBUG("       + %.2lf flops XRootD overhead", xrd_overhead_flops);
-        simgrid::s4u::ExecPtr exec = simgrid::s4u::this_actor::exec_init(num_flops);
+        simgrid::s4u::ExecPtr exec = this->initExec(num_flops);
+        DCSIM_PROFILE_COUNT(StreamedBlocks, 1);
         exec->start();
         double exec_start_time = exec->get_start_time();
         exec->wait();
@@ -156,3 +258,88 @@ void StreamedComputation::performComputation(const std::shared_ptr<wrench::Actio
     the_action->set_infile_transfer_time(infile_transfer_time);
     the_action->set_calculation_time(compute_time);
 }
+
+/**
+ * @brief Stream an input-file keeping up to SimpleSimulator::xrd_readahead block reads outstanding
+ * ahead of the block currently computed. Blocks are computed in order as soon as they have arrived.
+ *
+ * @param file Input-file to stream
+ * @param location Location to stream the file from
+ * @param file_local Whether the file is located on the executing host
+ * @param total_data_size Incremental size of all input-files of the job
+ * @param the_action Executed action
+ * @param infile_transfer_time Time any read of the file was in flight is added to it
+ * @param compute_time Time spent computing the blocks is added to it
+ *
+ * @throw std::runtime_error
+ */
+void StreamedComputation::streamWithReadahead(const std::shared_ptr<wrench::DataFile> &file,
+                                              const std::shared_ptr<wrench::FileLocation> &location,
+                                              const bool file_local, const sg_size_t total_data_size,
+                                              const std::shared_ptr<MonitorAction> &the_action,
+                                              double &infile_transfer_time, double &compute_time) {
+    sg_size_t file_size = file->getSize();
+    auto num_blocks = static_cast<int>(std::ceil(static_cast<double>(file_size) / static_cast<double>(SimpleSimulator::xrd_block_size)));
+
+    std::deque<std::shared_ptr<AsyncRead>> block_reads;
+    std::vector<std::shared_ptr<AsyncRead>> completed_reads;
+    sg_size_t bytes_requested = 0;
+    // Keep the read-ahead window filled
+    auto issue_reads = [&]() {
+        while (block_reads.size() < SimpleSimulator::xrd_readahead && bytes_requested < file_size) {
+            auto num_bytes = std::min<sg_size_t>(SimpleSimulator::xrd_block_size, file_size - bytes_requested);
+            awaitCachedBytes(file, bytes_requested + num_bytes);
+            block_reads.push_back(std::make_shared<AsyncRead>(location, num_bytes));
+            bytes_requested += num_bytes;
+        }
+    };
+
+    issue_reads();
+    double xrd_block_start_time = wrench::Simulation::getCurrentSimulatedDate();
+    for (int i = 0; i < num_blocks; i++) {
+        auto read = block_reads.front();
+        block_reads.pop_front();
+        read->wait();
+        feedCachedBytes(file, read->getNumBytes());
+        recordReadThroughput(location, read->getNumBytes(), read->getEndTime() - read->getStartTime());
+        if (read->getEndTime() >= read->getStartTime()) {
+            completed_reads.push_back(read);
+            WRENCH_INFO("Streaming computation received block %d of file %s", i, file->getID().c_str());
+        } else {
+            throw std::runtime_error(
+                    "Reading block " + std::to_string(i) +
+                    " of file " + file->getID() + " finished before it started!");
+        }
+        issue_reads();
+
+        double num_flops = determineFlops(read->getNumBytes(), total_data_size);
+        WRENCH_INFO("Chunk: %llu bytes / %.2lf flops", read->getNumBytes(), num_flops);
+        // Add XRootD FLOPs overhead that increments with execution time
+        double xrd_overhead_flops = 0;
+        if (!file_local) {
+            xrd_overhead_flops = SimpleSimulator::xrd_add_flops_per_time * (wrench::Simulation::getCurrentSimulatedDate() - xrd_block_start_time);
+        } else {
+            xrd_overhead_flops = SimpleSimulator::xrd_add_flops_local_per_time * (wrench::Simulation::getCurrentSimulatedDate() - xrd_block_start_time);
+        }
+        num_flops += xrd_overhead_flops;
+        WRENCH_DEBUG("       + %.2lf flops XRootD overhead", xrd_overhead_flops);
+        xrd_block_start_time = wrench::Simulation::getCurrentSimulatedDate();
+
+        simgrid::s4u::ExecPtr exec = this->initExec(num_flops);
+        DCSIM_PROFILE_COUNT(StreamedBlocks, 1);
+        exec->start();
+        double exec_start_time = exec->get_start_time();
+        exec->wait();
+        double exec_end_time = exec->get_finish_time();
+        if (exec_end_time >= exec_start_time) {
+            compute_time += exec_end_time - exec_start_time;
+            WRENCH_INFO("Streaming computation completed block %d of file %s", i, the_action->getJob()->getName().c_str());
+        } else {
+            throw std::runtime_error(
+                    "Executing block " + std::to_string(i) +
+                    " of job " + the_action->getJob()->getName() + " finished before it started!");
+        }
+    }
+
+    infile_transfer_time += AsyncRead::getBusyTime(completed_reads);
+}
@@ -7,6 +7,8 @@
 
 #include "CacheComputation.h"
 
+class MonitorAction;
+
 class StreamedComputation : public CacheComputation {
 
 public:
@@ -14,7 +16,7 @@ public:
     StreamedComputation(
             std::set<std::shared_ptr<wrench::StorageService>> &cache_storage_services,
             const std::set<std::shared_ptr<wrench::StorageService>> &grid_storage_services,
-            const std::vector<std::shared_ptr<wrench::DataFile>> &files,
+            const FileRange &files,
             double total_flops,
             bool prefetch_on);
 
@@ -22,6 +24,12 @@ public:
 
 private:
     bool prefetching_on;
+
+    void streamWithReadahead(const std::shared_ptr<wrench::DataFile> &file,
+                             const std::shared_ptr<wrench::FileLocation> &location,
+                             bool file_local, sg_size_t total_data_size,
+                             const std::shared_ptr<MonitorAction> &the_action,
+                             double &infile_transfer_time, double &compute_time);
 };
 
 #endif//S_STREAMEDCOMPUTATION_H
@@ -0,0 +1,1434 @@
+/**
+ * Copyright (c) 2020. <ADD YOUR HEADER INFORMATION>.
+ * Generated with the wrench-init.in tool.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+#include <wrench.h>
+#include "SimpleSimulator.h"
+#include "WorkloadExecutionController.h"
+#include "JobSpecification.h"
+#include "JobScheduler.h"
+#include "BlockCacheIndex.h"
+#include "CacheAdmission.h"
+#include "ScenarioCache.h"
+#include "monitoring/NetworkMonitor.h"
+#include "monitoring/CacheMonitor.h"
+#include "monitoring/Profiler.h"
+#include "monitoring/Heartbeat.h"
+
+#include "util/Utils.h"
+
+#include <simgrid/plugins/load.h>
+
+#include <iostream>
+#include <fstream>
+#include <functional>
+
+#include <boost/program_options.hpp>
+#include <boost/regex.hpp>
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string.hpp>
+#include <utility>
+
+namespace po = boost::program_options;
+
+/**
+ * Keys of the dataset and workload configurations
+ */
+const std::vector<std::string> dataset_keys = {
+        "location", "num_files",
+        "filesize"};
+const std::vector<std::string> mandatory_workload_keys = {
+        "num_jobs",
+        "flops", "memory", "outfilesize",
+        "workload_type", "submission_time"};
+const std::vector<std::string> mandatory_trace_workload_keys = {
+        "trace",
+        "workload_type", "submission_time"};
+const std::vector<std::string> elective_workload_keys = {
+        "infiles_per_job",
+        "infile_dataset",
+        "file_assignment",
+        "upstream_workloads",
+        "output_storage",
+        "cpu_scaling",
+};
+std::ofstream filedump;                                          // output file stream to write monitoring dump to
+
+
+/**
+ * @brief Simple Choices class for cache scope program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct cacheScope {
+    explicit cacheScope(std::string val) : value(std::move(val)) {}
+    std::string value;
+};
+/**
+ * @brief Operator<< for the cacheScope class
+ * 
+ * @param os 
+ * @param val 
+ * @return std::ostream& 
+ */
+std::ostream &operator<<(std::ostream &os, const cacheScope &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, cacheScope * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    if (s == "local" || s == "network" || s == "siblingnetwork") {
+        v = boost::any(cacheScope(s));
+    } else {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for streaming mode program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct StreamingModeValue {
+    explicit StreamingModeValue(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    // getter function
+    StreamingMode get() const {
+        return get_streaming_mode(value);
+    }
+};
+
+/**
+ * @brief Operator<< for the StreamingModeValue class
+ *
+ * @param os
+ * @param val
+ * @return std::ostream&
+ */
+std::ostream &operator<<(std::ostream &os, const StreamingModeValue &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, StreamingModeValue * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto mode = StreamingModeValue(s);
+    if (mode.value == "block" || mode.value == "fluid") {
+        v = boost::any(mode);
+    } else {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for cache fill mode program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct CacheFillModeValue {
+    explicit CacheFillModeValue(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    // getter function
+    CacheFillMode get() const {
+        return get_cache_fill_mode(value);
+    }
+};
+
+/**
+ * @brief Operator<< for the CacheFillModeValue class
+ *
+ * @param os
+ * @param val
+ * @return std::ostream&
+ */
+std::ostream &operator<<(std::ostream &os, const CacheFillModeValue &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, CacheFillModeValue * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto mode = CacheFillModeValue(s);
+    if (mode.value == "instant" || mode.value == "inflight") {
+        v = boost::any(mode);
+    } else {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for cache granularity program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct CacheGranularityValue {
+    explicit CacheGranularityValue(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    // getter function
+    CacheGranularity get() const {
+        return get_cache_granularity(value);
+    }
+};
+
+/**
+ * @brief Operator<< for the CacheGranularityValue class
+ *
+ * @param os
+ * @param val
+ * @return std::ostream&
+ */
+std::ostream &operator<<(std::ostream &os, const CacheGranularityValue &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, CacheGranularityValue * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto granularity = CacheGranularityValue(s);
+    if (granularity.value == "file" || granularity.value == "block") {
+        v = boost::any(granularity);
+    } else {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for cache admission program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct CacheAdmissionValue {
+    explicit CacheAdmissionValue(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    // getter function
+    CacheAdmissionPolicy get() const {
+        return get_cache_admission_policy(value);
+    }
+};
+
+/**
+ * @brief Operator<< for the CacheAdmissionValue class
+ *
+ * @param os
+ * @param val
+ * @return std::ostream&
+ */
+std::ostream &operator<<(std::ostream &os, const CacheAdmissionValue &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, CacheAdmissionValue * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto policy = CacheAdmissionValue(s);
+    if (policy.value == "always" || policy.value == "second-access" || policy.value == "size" ||
+        policy.value == "name" || policy.value == "probability") {
+        v = boost::any(policy);
+    } else {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for cache placement program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct CachePlacementValue {
+    explicit CachePlacementValue(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    // getter function
+    CachePlacementStrategy get() const {
+        return get_cache_placement_strategy(value);
+    }
+};
+
+/**
+ * @brief Operator<< for the CachePlacementValue class
+ *
+ * @param os
+ * @param val
+ * @return std::ostream&
+ */
+std::ostream &operator<<(std::ostream &os, const CachePlacementValue &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, CachePlacementValue * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto strategy = CachePlacementValue(s);
+    if (strategy.value == "random" || strategy.value == "hash" || strategy.value == "freespace" || strategy.value == "leastloaded") {
+        v = boost::any(strategy);
+    } else {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for replica selection program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct ReplicaSelectionValue {
+    explicit ReplicaSelectionValue(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    // getter function
+    ReplicaSelectionPolicy get() const {
+        return get_replica_selection_policy(value);
+    }
+};
+
+/**
+ * @brief Operator<< for the ReplicaSelectionValue class
+ *
+ * @param os
+ * @param val
+ * @return std::ostream&
+ */
+std::ostream &operator<<(std::ostream &os, const ReplicaSelectionValue &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, ReplicaSelectionValue * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto policy = ReplicaSelectionValue(s);
+    if (policy.value == "first" || policy.value == "bandwidth" || policy.value == "throughput" || policy.value == "roundrobin" || policy.value == "weighted") {
+        v = boost::any(policy);
+    } else {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for stage-out mode program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct StageOutModeValue {
+    explicit StageOutModeValue(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    // getter function
+    StageOutMode get() const {
+        return get_stage_out_mode(value);
+    }
+};
+
+/**
+ * @brief Operator<< for the StageOutModeValue class
+ *
+ * @param os
+ * @param val
+ * @return std::ostream&
+ */
+std::ostream &operator<<(std::ostream &os, const StageOutModeValue &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, StageOutModeValue * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto mode = StageOutModeValue(s);
+    if (mode.value == "direct" || mode.value == "local") {
+        v = boost::any(mode);
+    } else {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for workload type program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct WorkloadTypeStruct {
+    explicit WorkloadTypeStruct(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    // getter function
+    WorkloadType get() const {
+        return get_workload_type(value);
+    }
+};
+
+/**
+ * @brief Operator<< for the WorkloadTypeStruct class
+ * 
+ * @param os 
+ * @param val 
+ * @return std::ostream& 
+ */
+std::ostream &operator<<(std::ostream &os, const WorkloadTypeStruct &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, WorkloadTypeStruct * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto w = WorkloadTypeStruct(s);
+    try {
+        w.get();
+        v = boost::any(w);
+    } catch (std::runtime_error &e) {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief Simple Choices class for workload type program option
+ * used as Custom Validator: https://www.boost.org/doc/libs/1_48_0/doc/html/program_options/howto.html#id2445062
+ */
+struct StorageServiceBufferValue {
+    StorageServiceBufferValue(std::string const &val) : value(boost::to_lower_copy(val)) {}
+    std::string value;
+    StorageServiceBufferType type;
+    // getter function
+    StorageServiceBufferType getType() const {
+        return get_ssbuffer_type(value);
+    }
+    std::string get() const {
+        return value;
+    }
+};
+
+/**
+ * @brief Operator<< for the StorageServiceBufferValue class
+ * 
+ * @param os 
+ * @param val 
+ * @return std::ostream& 
+ */
+std::ostream &operator<<(std::ostream &os, const StorageServiceBufferValue &val) {
+    os << val.value << " ";
+    return os;
+}
+
+/**
+ * @brief Overload of boost::program_options validate method
+ * to check for custom validator classes
+ */
+void validate(boost::any &v, std::vector<std::string> const &values, StorageServiceBufferValue * /* target_type */, int) {
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    std::string const &s = validators::get_single_string(values);
+
+    auto ssp = StorageServiceBufferValue(s);
+    StorageServiceBufferType stype;
+    try {
+        stype = ssp.getType();
+        // Ensure that non-value options are parsed correctly
+        if (stype == StorageServiceBufferType::Zero) {
+            v = boost::any(StorageServiceBufferValue("0"));
+        } else if (stype == StorageServiceBufferType::Infinity) {
+            v = boost::any(StorageServiceBufferValue("infinity"));
+        } else {
+            v = boost::any(ssp);
+        }
+    } catch (std::runtime_error &e) {
+        throw validation_error(validation_error::invalid_option_value);
+    }
+}
+
+/**
+ * @brief helper function to process simulation options and parameters
+ * 
+ * @param argc
+ * @param argv 
+ * 
+ */
+po::variables_map process_program_options(int argc, char **argv) {
+
+    // default values
+    double hitrate = 0.0;
+
+    // HENRI: Commented the 9 lines below as they were not used (and include data-type weirdness)
+    // double average_flops = 2164.428 * 1000 * 1000 * 1000;
+    // double sigma_flops = 0.1 * average_flops;
+    // double average_memory = 2. * 1000 * 1000 * 1000;
+    // double sigma_memory = 0.1 * average_memory;
+    // size_t infiles_per_job = 10;
+    // double average_infile_size = 3600000000.;
+    // double sigma_infile_size = 0.1 * average_infile_size;
+    // double average_outfile_size = 0.5 * infiles_per_job * average_infile_size;
+    // double sigma_outfile_size = 0.1 * average_outfile_size;
+
+
+    size_t duplications = 1;
+
+    bool no_caching = false;
+    bool prefetch_off = false;
+    bool shuffle_jobs = false;
+
+    sg_size_t xrd_block_size = 1000 * 1000 * 1000;
+    double xrd_add_flops_per_time = 20000000000;
+    double xrd_add_flops_local_per_time = 0;
+    std::string storage_service_buffer_size = "1048576";// 1MiB
+
+    unsigned int seed = 42;
+
+    double network_monitor_interval = 0.;
+    double cache_monitor_window = 0.;
+
+    po::options_description desc("Allowed options");
+    auto op = desc.add_options();
+    op("help,h", "show brief usage message\n");
+    op("platform,p", po::value<std::string>()->value_name("<platform>")->required(), "platform description file, written in XML following the SimGrid-defined DTD")("hitrate,H", po::value<double>()->default_value(hitrate), "initial fraction of staged input-files on caches at simulation start");
+    op("workload-configurations", po::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{}, ""), "List of paths to .json files with workload configurations. Note that all job-specific commandline options will be ignored in case at least one configuration is provided.")("dataset-configurations", po::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{}, ""), "List of paths to .json files with dataset configurations.");
+    op("duplications,d", po::value<size_t>()->default_value(duplications), "number of duplications of the workload to feed into the simulation");
+    op("no-caching", po::bool_switch()->default_value(no_caching), "switch to turn on/off the caching of jobs' input-files")("prefetch-off", po::bool_switch()->default_value(prefetch_off), "switch to turn on/off prefetching for streaming of input-files")("shuffle-jobs", po::bool_switch()->default_value(shuffle_jobs), "switch to turn on/off shuffling jobs during submission");
+    op("output-file,o", po::value<std::string>()->value_name("<out file>")->required(), "path for the CSV file containing output information about the jobs in the simulation");
+    op("xrd-blocksize,x", po::value<sg_size_t>()->default_value(xrd_block_size), "size of the blocks XRootD uses for data streaming")("storage-buffer-size,b", po::value<StorageServiceBufferValue>()->default_value(StorageServiceBufferValue(storage_service_buffer_size)), "buffer size used by the storage services when communicating data");
+    op("xrd-flops-per-time", po::value<double>()->default_value(xrd_add_flops_per_time), "flops overhead introduced by XRootD data streaming per second");
+    op("xrd-flops-per-time-local", po::value<double>()->default_value(xrd_add_flops_local_per_time), "flops overhead introduced by XRootD data streaming from local storage per second");
+    op("xrd-streaming-mode", po::value<StreamingModeValue>()->default_value(StreamingModeValue("block")), "engine used for streaming input-files:\n block: one read and one compute activity per XRootD block\n fluid: one coalesced read and compute per file with analytically modelled pipelining (much fewer simulation events, an approximation of the block engine)");
+    op("copy-concurrency", po::value<unsigned int>()->default_value(1), "number of input-files read concurrently by jobs copying their input-files before computing");
+    op("xrd-readahead", po::value<unsigned int>()->default_value(0), "number of asynchronous block reads kept in flight ahead of the computed block while streaming with prefetching in block mode (0 keeps the single block prefetching)");
+    op("cache-scope", po::value<cacheScope>()->default_value(cacheScope("local")), "Set the network scope in which caches can be found:\n local: only caches on same machine\n network: caches in same network zone\n siblingnetwork: also include caches in sibling networks");
+    op("cache-fill-mode", po::value<CacheFillModeValue>()->default_value(CacheFillModeValue("instant")), "Set how files missed in a cache become available there:\n instant: the file is created in the cache at once\n inflight: the first job reading the file writes it into the cache block by block, concurrent jobs wait for the blocks instead of reading from the GRID");
+    op("cache-write-queue", po::value<unsigned int>()->default_value(0), "number of block writes each cache's writer actor queues, which writes the data filled into the cache onto its disk asynchronously to the reading jobs (0: in-flight fills and block-granular fills are written by the reading job, instant fills are not written)");
+    op("cache-granularity", po::value<CacheGranularityValue>()->default_value(CacheGranularityValue("file")), "Set the units in which caches hold input-files:\n file: files are looked up and cached as a whole\n block: streamed files are looked up and cached block by block (see --xrd-blocksize), only the missing blocks are read from the GRID");
+    op("cache-admission", po::value<CacheAdmissionValue>()->default_value(CacheAdmissionValue("always")), "Set the policy deciding whether a missed file is written into a cache:\n always: every missed file\n second-access: files missed again while remembered among the last refused files\n size: files within the size range\n name: files of the listed datasets or read by jobs of the listed workloads\n probability: files drawn with the admission probability");
+    op("cache-admission-ghost-size", po::value<size_t>()->default_value(SimpleSimulator::cache_admission_ghost_size), "number of refused files remembered by the second-access admission policy");
+    op("cache-admission-min-size", po::value<sg_size_t>()->default_value(0), "smallest file size in bytes admitted by the size admission policy")("cache-admission-max-size", po::value<sg_size_t>()->default_value(0), "largest file size in bytes admitted by the size admission policy (0 for no limit)");
+    op("cache-admission-names", po::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{}, ""), "names of the datasets and workloads admitted by the name admission policy");
+    op("cache-admission-probability", po::value<double>()->default_value(1.), "probability with which the probability admission policy admits a file");
+    op("cache-placement", po::value<CachePlacementValue>()->default_value(CachePlacementValue("random")), "Set the strategy choosing the reachable cache a missed file is written to:\n random: any cache, drawn with the seeded random generator\n hash: stable home per file by hashing its ID over the caches\n freespace: cache with the most free space\n leastloaded: cache with the fewest jobs reading from or filling it");
+    op("replica-selection", po::value<ReplicaSelectionValue>()->default_value(ReplicaSelectionValue("first")), "Set the policy choosing the GRID storage a file not found in any cache is read from:\n first: first storage holding the file\n bandwidth: shortest transfer time estimated from route bandwidth and latency\n throughput: highest decaying average of the observed throughput\n roundrobin: cycle through the storages holding the file\n weighted: random, weighted by the storages' disk read bandwidth");
+    op("stage-out", po::value<StageOutModeValue>()->default_value(StageOutModeValue("direct")), "Set how jobs write their output-files to the GRID:\n direct: the job writes to the GRID storage of its workload and keeps its slot until the write has finished\n local: the job writes to a reachable cache and frees its slot, the site's upload agent pushes the file to the GRID asynchronously")("stage-out-uploads", po::value<unsigned int>()->default_value(SimpleSimulator::stage_out_uploads), "number of output-files the upload agent of each site pushes to the GRID concurrently in the local stage-out mode");
+    op("seed,s", po::value<unsigned int>()->default_value(seed), "Set the seed for the random generator");
+    op("sampling-threads", po::value<unsigned int>()->default_value(0), "number of threads sampling the files of datasets and the jobs of workloads (0: all hardware threads), the samples don't depend on it");
+    op("network-monitor-interval", po::value<double>()->default_value(network_monitor_interval), "simulated time in seconds between two samples of link and disk load taken on the networkmonitor host (0 disables monitoring)")("network-monitor-output", po::value<std::string>()->value_name("<out file>")->default_value(""), "path for the CSV file containing the link and disk load time series (default: derived from the output-file)");
+    op("cache-monitor-window", po::value<double>()->default_value(cache_monitor_window), "length in simulated seconds of the time windows in which per-cache hit, miss, eviction and occupancy statistics are aggregated (0 disables cache monitoring)")("cache-monitor-output", po::value<std::string>()->value_name("<out file>")->default_value(""), "path for the CSV file containing the per-cache time series (default: derived from the output-file)");
+    op("scenario-cache", po::value<std::string>()->value_name("<cache file>")->default_value(""), "path for a binary file the sampled datasets and workloads are written to, which later runs with the same configuration files and seed map instead of sampling again (empty disables the cache)");
+    op("profile-output", po::value<std::string>()->value_name("<out file>")->default_value(""), "path for a JSON file containing wall-clock timings of the simulator phases and hot path counters (empty disables self-profiling)");
+    op("heartbeat-interval", po::value<double>()->default_value(0.), "wall-clock seconds between two progress reports of the running simulation (0 disables the heartbeat)")("heartbeat-output", po::value<std::string>()->value_name("<out file>")->default_value(""), "path for a file the progress reports are appended to (default: stderr)");
+
+    po::variables_map vm;
+    po::store(
+            po::parse_command_line(argc, argv, desc),
+            vm);
+
+    if (vm.count("help")) {
+        std::cerr << desc << std::endl;
+        exit(EXIT_SUCCESS);
+    }
+
+    try {
+        po::notify(vm);
+    } catch (std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl
+                  << std::endl;
+        std::cerr << desc << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // Here, all options should be properly set
+    std::cerr << "Using platform " << vm["platform"].as<std::string>() << std::endl;
+
+    return vm;
+}
+
+
+/**
+ * @brief Create the CPU scaling model of a workload from its configuration. Without a model,
+ * calculations speed up ideally with their cores, while streaming and copy jobs compute on a single core.
+ *
+ * @param workload_config JSON configuration of the workload
+ * @param workload_type Workload type in lower case
+ * @return the CPU scaling model
+ *
+ * @throw std::runtime_error
+ */
+CpuScaling getCpuScaling(const nlohmann::json &workload_config, const std::string &workload_type) {
+    if (workload_config.contains("cpu_scaling")) {
+        return CpuScaling(workload_config["cpu_scaling"]);
+    }
+    if (workload_type == "calculation") {
+        return CpuScaling(nlohmann::json{{"type", "efficiency"}, {"efficiency", 1.}});
+    }
+    return CpuScaling();
+}
+
+/**
+ * @brief Check that the upstream workloads of each workload are configured
+ * and that no workload depends on its own output-files, directly or through other workloads
+ *
+ * @param workloads All workloads
+ *
+ * @throw std::runtime_error
+ */
+void checkWorkloadDependencies(const std::vector<Workload> &workloads) {
+    std::map<std::string, const Workload *> workloads_by_name;
+    for (auto const &ws: workloads) {
+        workloads_by_name[ws.name] = &ws;
+    }
+    for (auto const &ws: workloads) {
+        if (!ws.upstream_workloads.empty() && ws.workload_type == WorkloadType::Calculation) {
+            throw std::runtime_error("ERROR: calculation workload " + ws.name + " reads no input-files and can't have upstream workloads.");
+        }
+        for (auto const &upstream_name: ws.upstream_workloads) {
+            if (workloads_by_name.find(upstream_name) == workloads_by_name.end()) {
+                throw std::runtime_error("ERROR: upstream workload " + upstream_name + " of workload " + ws.name + " is not configured.");
+            }
+        }
+    }
+    // Depth-first search, a workload on the current path being reached again closes a cycle
+    enum Visit { Unvisited,
+                 OnPath,
+                 Done };
+    std::map<std::string, Visit> visits;
+    std::function<void(const Workload *)> visit = [&](const Workload *ws) {
+        visits[ws->name] = OnPath;
+        for (auto const &upstream_name: ws->upstream_workloads) {
+            Visit upstream_visit = visits[upstream_name];
+            if (upstream_visit == OnPath) {
+                throw std::runtime_error("ERROR: workload " + upstream_name + " depends on its own output-files through workload " + ws->name + ".");
+            }
+            if (upstream_visit == Unvisited) {
+                visit(workloads_by_name[upstream_name]);
+            }
+        }
+        visits[ws->name] = Done;
+    };
+    for (auto const &ws: workloads) {
+        if (visits[ws.name] == Unvisited) {
+            visit(&ws);
+        }
+    }
+}
+
+
+/**
+ * @brief Method to duplicate the jobs of a workload
+ * 
+ * @param workload Workload containing jobs to duplicate
+ * @param duplications Number of duplications each job is duplicated
+ * @return std::map<std::string, JobSpecification> 
+ */
+std::map<std::string, JobSpecification> duplicateJobs(std::map<std::string, JobSpecification> &workload, size_t duplications) {
+    size_t num_jobs = workload.size();
+    std::map<std::string, JobSpecification> dupl_workload;
+    std::cerr << "\tDuplicating workload " << &workload << " with " << std::to_string(num_jobs) << " jobs ";
+    for (auto &job_spec: workload) {
+        boost::smatch job_index_matches;
+        boost::regex job_index_expression{"\\d+"};
+        boost::regex_search(job_spec.first, job_index_matches, job_index_expression);
+        for (size_t d = 0; d < duplications; d++) {
+            size_t dup_index;
+            std::stringstream job_index_sstream(job_index_matches[job_index_matches.size() - 1]);
+            job_index_sstream >> dup_index;
+            dup_index += num_jobs * d;
+            std::string dupl_job_id = boost::replace_last_copy(job_spec.first, job_index_matches[job_index_matches.size() - 1], std::to_string(dup_index));
+            JobSpecification dupl_job_specs = job_spec.second;
+            if (d > 0) {
+                // The output-file of each duplicate is registered under the duplicate's index when it is submitted,
+                // downstream workloads only read the ones of the original jobs
+                dupl_job_specs.outfiles = nullptr;
+                dupl_job_specs.outfile_index = dup_index;
+            }
+            dupl_workload.insert(std::make_pair(dupl_job_id, dupl_job_specs));
+        }
+    }
+    std::cerr << "-> New workload has " << dupl_workload.size() << " jobs\n";
+    return dupl_workload;
+}
+
+
+
+int main(int argc, char **argv) {
+
+    // instantiate a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+
+    // Initialization of the simulation
+    simulation->init(&argc, argv);
+
+    /* Parsing of the command-line arguments for this WRENCH simulation */
+    auto vm = process_program_options(argc, argv);
+
+    // The first argument is the platform description file, written in XML following the SimGrid-defined DTD
+    std::string platform_file = vm["platform"].as<std::string>();
+
+    // output-file name containing simulation information
+    std::string filename = vm["output-file"].as<std::string>();
+
+    size_t duplications = vm["duplications"].as<size_t>();
+
+    double hitrate = vm["hitrate"].as<double>();
+
+    std::vector<std::string> workload_configurations = vm["workload-configurations"].as<std::vector<std::string>>();
+
+    // dataset-configurations name containing datasets infomration
+    std::vector<std::string> dataset_configurations = vm["dataset-configurations"].as<std::vector<std::string>>();
+
+    // Flags to turn on/off the caching of jobs' input-files
+    SimpleSimulator::infile_caching_on = !(vm["no-caching"].as<bool>());
+
+    // Flags to turn prefetching for streaming of input-files
+    std::cerr << "Prefetching switch off?: " << vm["prefetch-off"].as<bool>() << std::endl;
+    SimpleSimulator::prefetching_on = !(vm["prefetch-off"].as<bool>());
+
+    // Flag to turn on shuffling of jobs
+    std::cerr << "Job shuffling on?: " << vm["shuffle-jobs"].as<bool>() << std::endl;
+    SimpleSimulator::shuffle_jobs = vm["shuffle-jobs"].as<bool>();
+
+    // Set XRootD block size
+    SimpleSimulator::xrd_block_size = vm["xrd-blocksize"].as<sg_size_t>();
+    SimpleSimulator::xrd_add_flops_per_time = vm["xrd-flops-per-time"].as<double>();
+    SimpleSimulator::xrd_add_flops_local_per_time = vm["xrd-flops-per-time-local"].as<double>();
+    SimpleSimulator::xrd_streaming_mode = vm["xrd-streaming-mode"].as<StreamingModeValue>().get();
+    SimpleSimulator::xrd_readahead = vm["xrd-readahead"].as<unsigned int>();
+    SimpleSimulator::copy_concurrency = vm["copy-concurrency"].as<unsigned int>();
+
+    // Set StorageService buffer size/type
+    std::string buffer_size = vm["storage-buffer-size"].as<StorageServiceBufferValue>().get();
+
+    // Choice of cache locality scope
+    std::string scope_caches = vm["cache-scope"].as<cacheScope>().value;
+    SimpleSimulator::cache_fill_mode = vm["cache-fill-mode"].as<CacheFillModeValue>().get();
+    SimpleSimulator::cache_write_queue = vm["cache-write-queue"].as<unsigned int>();
+    SimpleSimulator::cache_granularity = vm["cache-granularity"].as<CacheGranularityValue>().get();
+    SimpleSimulator::cache_admission = vm["cache-admission"].as<CacheAdmissionValue>().get();
+    SimpleSimulator::cache_admission_ghost_size = vm["cache-admission-ghost-size"].as<size_t>();
+    SimpleSimulator::cache_admission_min_size = vm["cache-admission-min-size"].as<sg_size_t>();
+    SimpleSimulator::cache_admission_max_size = vm["cache-admission-max-size"].as<sg_size_t>();
+    auto cache_admission_names = vm["cache-admission-names"].as<std::vector<std::string>>();
+    SimpleSimulator::cache_admission_names = std::set<std::string>(cache_admission_names.begin(), cache_admission_names.end());
+    SimpleSimulator::cache_admission_probability = vm["cache-admission-probability"].as<double>();
+    if (SimpleSimulator::cache_admission_probability < 0. || SimpleSimulator::cache_admission_probability > 1.) {
+        std::cerr << "The cache admission probability has to be within [0, 1]!" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    SimpleSimulator::cache_placement = vm["cache-placement"].as<CachePlacementValue>().get();
+    SimpleSimulator::replica_selection = vm["replica-selection"].as<ReplicaSelectionValue>().get();
+    SimpleSimulator::stage_out_mode = vm["stage-out"].as<StageOutModeValue>().get();
+    SimpleSimulator::stage_out_uploads = vm["stage-out-uploads"].as<unsigned int>();
+    if (SimpleSimulator::stage_out_uploads == 0) {
+        std::cerr << "The upload agents need to push at least one output-file at a time!" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    bool rec_netzone_caches = false;
+    if (scope_caches.find("network") == std::string::npos) {
+        SimpleSimulator::local_cache_scope = true;
+    } else {
+        if (scope_caches.find("sibling") != std::string::npos) {
+            rec_netzone_caches = true;
+        }
+    }
+
+    // Network and disk load monitoring
+    double network_monitor_interval = vm["network-monitor-interval"].as<double>();
+    std::string network_monitor_filename = vm["network-monitor-output"].as<std::string>();
+    if (network_monitor_filename.empty()) {
+        network_monitor_filename = derive_output_path(filename, "netmonitor");
+    }
+
+    // Per-cache statistics
+    double cache_monitor_window = vm["cache-monitor-window"].as<double>();
+    std::string cache_monitor_filename = vm["cache-monitor-output"].as<std::string>();
+    if (cache_monitor_filename.empty()) {
+        cache_monitor_filename = derive_output_path(filename, "cachemonitor");
+    }
+
+    // Self-profiling of the simulator
+    std::string profile_filename = vm["profile-output"].as<std::string>();
+    Profiler::enabled = !profile_filename.empty();
+
+    // Progress reports
+    double heartbeat_interval = vm["heartbeat-interval"].as<double>();
+    std::string heartbeat_filename = vm["heartbeat-output"].as<std::string>();
+
+    /* Set seed for random engine */
+
+    unsigned int seed = vm["seed"].as<unsigned int>();
+    SimpleSimulator::gen.seed(seed);
+    SimpleSimulator::sampling_threads = vm["sampling-threads"].as<unsigned int>();
+
+    /* Load datasets and workloads sampled by a previous run of the same scenario */
+
+    std::vector<Dataset> dataset_specs = {};
+    std::vector<Workload> workload_specs = {};
+
+    std::string scenario_cache = vm["scenario-cache"].as<std::string>();
+    uint64_t scenario_key = 0;
+    bool scenario_cached = false;
+    if (!scenario_cache.empty()) {
+        DCSIM_PROFILE_START(ScenarioLoading);
+        scenario_key = ScenarioCache::key(seed, dataset_configurations, workload_configurations);
+        try {
+            scenario_cached = ScenarioCache::load(scenario_cache, scenario_key, dataset_specs, workload_specs);
+        } catch (std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        DCSIM_PROFILE_STOP(ScenarioLoading);
+        if (scenario_cached) {
+            std::cerr << "Loaded " << dataset_specs.size() << " datasets and " << workload_specs.size()
+                      << " workloads from scenario cache " << scenario_cache << std::endl;
+        }
+    }
+
+    /* Create datasets */
+
+    std::cerr << "Constructing dataset specifications..." << std::endl;
+    DCSIM_PROFILE_START(DatasetConstruction);
+
+    if (scenario_cached) {
+        // Datasets have been loaded from the scenario cache
+    } else if (dataset_configurations.empty()) {
+        //Default dataset config
+    } else {
+        for (auto &ds_confpath: dataset_configurations) {
+            std::ifstream ds_conf(ds_confpath);
+            nlohmann::json dss_json = nlohmann::json::parse(ds_conf);
+
+            // Looping over the multiple workloads configured in the json file
+            for (auto &ds: dss_json.items()) {
+
+                // Checking json syntax to match workload spec
+                for (auto &ds_key: dataset_keys) {
+                    try {
+                        if (!ds.value().contains(ds_key)) {
+                            throw std::invalid_argument("ERROR: the dataset configuration " + ds_confpath + " must contain " + ds_key + " as information.");
+                        }
+                    } catch (std::invalid_argument &e) {
+                        std::cerr << e.what() << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                std::vector<std::string> location{};
+                if (ds.value()["location"].type() == nlohmann::json::value_t::string)
+                    location = {ds.value()["location"]};
+                else
+                    location = ds.value()["location"].get<std::vector<std::string>>();
+                dataset_specs.push_back(
+                        Dataset(
+                                // TODO: support simple strings when only one host is required as location
+                                location,
+                                ds.value()["num_files"],
+                                ds.value()["filesize"],
+                                ds.key(),
+                                seed));
+                std::cerr << "\tDataset " << std::string(ds.key()) << " loaded" << std::endl;
+            }
+        }
+    }
+    DCSIM_PROFILE_STOP(DatasetConstruction);
+    std::cerr << "Created " << dataset_specs.size() << " unique datasets!"
+              << "\n";
+
+
+    /* Create a workload */
+    std::cerr << "Constructing workload specification..." << std::endl;
+
+    try {
+        if (workload_configurations.size() == 0)
+            throw std::invalid_argument("ERROR: the workload configuration loaded is invalid or empty.");
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    DCSIM_PROFILE_START(WorkloadSampling);
+    if (!scenario_cached) {
+        for (auto &wf_confpath: workload_configurations) {
+            std::ifstream wf_conf(wf_confpath);
+            try {
+                if (!wf_conf.is_open())
+                    throw std::runtime_error("File " + wf_confpath + " could not be opened!");
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            nlohmann::json wfs_json = nlohmann::json::parse(wf_conf);
+
+            // Looping over the multiple workloads configured in the json file
+            for (auto &wf: wfs_json.items()) {
+                // Checking json syntax to match workload spec
+                bool is_trace = wf.value().contains("trace");
+                for (auto &wf_key: (is_trace ? mandatory_trace_workload_keys : mandatory_workload_keys)) {
+                    try {
+                        if (!wf.value().contains(wf_key)) {
+                            throw std::invalid_argument("ERROR: the workload configuration " + wf_confpath + " must contain " + wf_key + " as information.");
+                        }
+                    } catch (std::invalid_argument &e) {
+                        std::cerr << e.what() << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                std::string workload_type_lower = boost::to_lower_copy(std::string(wf.value()["workload_type"]));
+                // Workloads reading the output-files of upstream workloads may do without infile datasets
+                std::vector<std::string> upstream_workloads{};
+                if (wf.value().contains("upstream_workloads")) {
+                    if (wf.value()["upstream_workloads"].type() == nlohmann::json::value_t::string)
+                        upstream_workloads = {wf.value()["upstream_workloads"]};
+                    else
+                        upstream_workloads = wf.value()["upstream_workloads"].get<std::vector<std::string>>();
+                }
+                bool has_infile_datasets = upstream_workloads.empty() || wf.value().contains("infile_datasets");
+                if (is_trace) {
+                    std::vector<std::string> infile_datasets{};
+                    if (workload_type_lower != "calculation" && has_infile_datasets) {
+                        if (wf.value()["infile_datasets"].type() == nlohmann::json::value_t::string)
+                            infile_datasets = {wf.value()["infile_datasets"]};
+                        else
+                            infile_datasets = wf.value()["infile_datasets"].get<std::vector<std::string>>();
+                    }
+                    try {
+                        workload_specs.push_back(
+                                Workload(
+                                        wf.value()["trace"],
+                                        wf.value().value("trace_lookahead", static_cast<size_t>(10000)),
+                                        wf.value().value("core_speed", 0.),
+                                        wf.value().value("trace_lfn_dataset", std::string()),
+                                        get_workload_type(workload_type_lower), wf.key(),
+                                        wf.value()["submission_time"],
+                                        infile_datasets));
+                    } catch (std::runtime_error &e) {
+                        std::cerr << e.what() << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    workload_specs.back().upstream_workloads = upstream_workloads;
+                    workload_specs.back().output_storage = wf.value().value("output_storage", std::string());
+                    try {
+                        workload_specs.back().cpu_scaling = getCpuScaling(wf.value(), workload_type_lower);
+                    } catch (std::runtime_error &e) {
+                        std::cerr << e.what() << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    std::cerr << "\tThe workload " << std::string(wf.key()) << " replays the job trace " << std::string(wf.value()["trace"]) << std::endl;
+                    continue;
+                }
+                if (workload_type_lower != "calculation") {
+                    std::vector<std::string> infile_datasets{};
+                    if (has_infile_datasets) {
+                        if (wf.value()["infile_datasets"].type() == nlohmann::json::value_t::string)
+                            infile_datasets = {wf.value()["infile_datasets"]};
+                        else
+                            infile_datasets = wf.value()["infile_datasets"].get<std::vector<std::string>>();
+                    }
+                    InfileAssignment file_assignment;
+                    try {
+                        file_assignment = InfileAssignment(wf.value().value("file_assignment", nlohmann::json::object()),
+                                                           wf.value().value("infiles_per_job", static_cast<size_t>(0)));
+                    } catch (std::runtime_error &e) {
+                        std::cerr << e.what() << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    workload_specs.push_back(
+                            Workload(
+                                    wf.value()["num_jobs"],
+                                    wf.value()["cores"],
+                                    wf.value()["flops"], wf.value()["memory"],
+                                    wf.value()["outfilesize"],
+                                    get_workload_type(workload_type_lower), wf.key(),
+                                    wf.value()["submission_time"],
+                                    seed,
+                                    infile_datasets,
+                                    file_assignment));
+                } else {
+                    workload_specs.push_back(
+                            Workload(
+                                    wf.value()["num_jobs"],
+                                    wf.value()["cores"],
+                                    wf.value()["flops"], wf.value()["memory"],
+                                    wf.value()["outfilesize"],
+                                    get_workload_type(workload_type_lower), wf.key(),
+                                    wf.value()["submission_time"],
+                                    seed));
+                }
+                workload_specs.back().upstream_workloads = upstream_workloads;
+                workload_specs.back().output_storage = wf.value().value("output_storage", std::string());
+                try {
+                    workload_specs.back().cpu_scaling = getCpuScaling(wf.value(), workload_type_lower);
+                } catch (std::runtime_error &e) {
+                    std::cerr << e.what() << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                std::cerr << "\tThe workload " << std::string(wf.key()) << " has " << wf.value()["num_jobs"] << " unique jobs" << std::endl;
+            }
+        }
+    }
+    DCSIM_PROFILE_STOP(WorkloadSampling);
+    std::cerr << "Created " << workload_specs.size() << " unique workloads!"
+              << "\n";
+
+    /* Add infiles to worklaod */
+
+    DCSIM_PROFILE_START(FileAssignment);
+    try {
+        checkWorkloadDependencies(workload_specs);
+        if (!scenario_cached) {
+            for (auto &ws: workload_specs) {
+                if (ws.workload_type == WorkloadType::Calculation)
+                    continue;
+                ws.assignFiles(dataset_specs, workload_specs);
+            }
+        }
+    } catch (std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    DCSIM_PROFILE_STOP(FileAssignment);
+
+    if (!scenario_cache.empty() && !scenario_cached) {
+        try {
+            ScenarioCache::store(scenario_cache, scenario_key, dataset_specs, workload_specs);
+            std::cerr << "Wrote sampled datasets and workloads to scenario cache " << scenario_cache << std::endl;
+        } catch (std::runtime_error &e) {
+            std::cerr << "WARNING: " << e.what() << std::endl;
+        }
+    }
+
+
+    /* Read and parse the platform description file to instantiate a simulation platform */
+    std::cerr << "Instantiating SimGrid platform..." << std::endl;
+    if (network_monitor_interval > 0.) {
+        // The link load plugin has to be initialized before the links are created
+        sg_link_load_plugin_init();
+    }
+    DCSIM_PROFILE_START(PlatformInstantiation);
+    simulation->instantiatePlatform(platform_file);
+    DCSIM_PROFILE_STOP(PlatformInstantiation);
+
+
+    /* Identify demanded and create storage and compute services and add them to the simulation */
+    SimpleSimulator::identifyHostTypes(simulation);
+
+    // Fill reachable caches map
+    if (rec_netzone_caches) {
+        SimpleSimulator::fillHostsInSiblingZonesMap();
+    } else {
+        for (const auto &hostnamesByZone: wrench::S4U_Simulation::getAllHostnamesByZone()) {
+            std::vector<std::string> hostnamesVec = hostnamesByZone.second;
+            std::set<std::string> hostnamesSet(hostnamesVec.begin(), hostnamesVec.end());
+            SimpleSimulator::hosts_in_zones[hostnamesByZone.first] = hostnamesSet;
+        }
+    }
+
+    // Create a list of cache storage services
+    std::set<std::shared_ptr<wrench::StorageService>> cache_storage_services;
+    for (auto const &host: SimpleSimulator::cache_hosts) {
+        //TODO: Support more than one type of cache mounted differently?
+        //TODO: This might not be necessary since different cache layers are typically on different hosts
+        auto storage_service = simulation->add(
+                wrench::SimpleStorageService::createSimpleStorageService(
+                        host, {"/"},
+                        {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, buffer_size}},
+                        {}));
+        SimpleSimulator::global_file_map[storage_service].setEvictionPolicy(SimpleSimulator::cache_eviction_policies[host]);
+        cache_storage_services.insert(storage_service);
+    }
+
+    // and remote storages that are able to serve all file requests
+
+    std::set<std::shared_ptr<wrench::StorageService>> grid_storage_services;
+    for (auto const &host: SimpleSimulator::storage_hosts) {
+        auto storage_service = simulation->add(
+                wrench::SimpleStorageService::createSimpleStorageService(
+                        host, {"/"},
+                        {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, buffer_size}},
+                        {}));
+        grid_storage_services.insert(storage_service);
+    }
+
+    // Create a list of compute services that will be used by the HTCondorService
+    std::vector<std::shared_ptr<wrench::ComputeService>> compute_services;
+    for (auto const &host: SimpleSimulator::worker_hosts) {
+        compute_services.push_back(
+                simulation->add(
+                        new wrench::BareMetalComputeService(
+                                host,
+                                {std::make_pair(
+                                        host,
+                                        std::make_tuple(
+                                                wrench::Simulation::getHostNumCores(host),
+                                                wrench::Simulation::getHostMemoryCapacity(host)))},
+                                "")));
+    }
+
+//    // Instantiate a HTcondorComputeService and add it to the simulation
+//    std::set<std::shared_ptr<wrench::HTCondorComputeService>> htcondor_compute_services;
+//    //TODO: Think of a way to support more than one HTCondor scheduler
+//    if (SimpleSimulator::scheduler_hosts.size() != 1) {
+//        throw std::runtime_error("Currently this simulator supports only a single HTCondor scheduler!");
+//    }
+//    for (auto host: SimpleSimulator::scheduler_hosts) {
+//        htcondor_compute_services.insert(
+//                simulation->add(
+//                        new wrench::HTCondorComputeService(
+//                                host,
+//                                condor_compute_resources,
+//                                {{wrench::HTCondorComputeServiceProperty::NEGOTIATOR_OVERHEAD, "0.0"},
+//                                 {wrench::HTCondorComputeServiceProperty::GRID_PRE_EXECUTION_DELAY, "0.0"},
+//                                 {wrench::HTCondorComputeServiceProperty::GRID_POST_EXECUTION_DELAY, "0.0"},
+//                                 {wrench::HTCondorComputeServiceProperty::NON_GRID_PRE_EXECUTION_DELAY, "0.0"},
+//                                 {wrench::HTCondorComputeServiceProperty::NON_GRID_POST_EXECUTION_DELAY, "0.0"}},
+//                                {})));
+//    }
+
+
+    /* Instantiate file registry services */
+    std::set<std::shared_ptr<wrench::FileRegistryService>> file_registry_services;
+    for (auto const &host : SimpleSimulator::file_registries) {
+        std::cerr << "Instantiating a FileRegistryService on " << host << "..." << std::endl;
+        auto file_registry_service = simulation->add(new wrench::FileRegistryService(host));
+        file_registry_services.insert(file_registry_service);
+    }
+
+    /* Create the JobScheduler */
+    auto job_scheduler = std::make_shared<JobScheduler>(compute_services);
+
+    /* Instantiate Execution Controllers */
+    std::vector<std::shared_ptr<WorkloadExecutionController>> workload_execution_controllers;
+    //TODO: Think of a way to support more than one execution controller host
+    if (SimpleSimulator::executors.size() != 1) {
+        throw std::runtime_error("Currently this simulator supports only a single host running workload execution controllers!");
+    }
+    std::cerr << "Creating workload execution controllers..."
+              << "\n";
+    for (auto const &host: SimpleSimulator::executors) {
+        for (auto &workload_spec: workload_specs) {
+            std::shared_ptr<WorkloadExecutionController> wms;
+            try {
+                wms = simulation->add(
+                        new WorkloadExecutionController(
+                                workload_spec,
+                                job_scheduler,
+                                grid_storage_services,
+                                cache_storage_services,
+                                host,
+                                filename,
+                                SimpleSimulator::shuffle_jobs,
+                                SimpleSimulator::gen));
+            } catch (std::runtime_error &e) {
+                std::cerr << "Exception: " << e.what() << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            std::cerr << "\tCreated execution controller " << wms->getName() << " executing workload " << &workload_spec << " with " << workload_spec.job_batch.size() << " jobs to simulate\n";
+            workload_execution_controllers.push_back(wms);
+        }
+        std::cerr << "Total number of execution controllers: " << workload_execution_controllers.size() << "\n";
+    }
+    // Let upstream workloads notify downstream ones of the output-files written
+    for (size_t w = 0; w < workload_specs.size(); w++) {
+        for (auto const &upstream_name: workload_specs[w].upstream_workloads) {
+            for (size_t u = 0; u < workload_specs.size(); u++) {
+                if (workload_specs[u].name == upstream_name) {
+                    workload_execution_controllers[u]->addDownstream(workload_execution_controllers[w].get());
+                }
+            }
+        }
+    }
+
+
+    /* Initialize the cache monitor */
+    if (cache_monitor_window > 0.) {
+        try {
+            CacheMonitor::init(cache_storage_services, cache_monitor_filename, cache_monitor_window);
+        } catch (std::runtime_error &e) {
+            std::cerr << "Exception: " << e.what() << std::endl;
+            return 0;
+        }
+        std::cerr << "Writing cache statistics to " << cache_monitor_filename << std::endl;
+    }
+
+
+    /* Instantiate inputfiles and set outfile destinations*/
+    std::cerr << "Creating and staging input files" << std::endl;
+    DCSIM_PROFILE_START(InputStaging);
+    try {
+        for (auto const &dss: dataset_specs) {
+            //TODO: Add total_file_size as dataset property
+
+            // Distribute the dataset files on specified GRID storages, on which each file is created
+            // once it is registered with the simulation when a job first accesses it
+            //TODO: Think of a more realistic distribution pattern and avoid duplications
+            std::vector<std::shared_ptr<wrench::StorageService>> dataset_storages;
+            for (auto const &storage_service: grid_storage_services) {
+                if (std::find(dss.hostnames.begin(), dss.hostnames.end(), storage_service->getHostname()) == dss.hostnames.end())
+                    continue;
+                dataset_storages.push_back(storage_service);
+            }
+            dss.files->stageOn(dataset_storages);
+        }
+        for (auto const &wms: workload_execution_controllers) {
+            for (auto &job_spec: wms->get_workload_spec()) {
+                sg_size_t incr_infile_size = 0.;
+                sg_size_t cached_files_size = 0.;
+                // Output-files of upstream workloads don't exist yet and can't be staged
+                auto const &infiles = job_spec.second.infiles;
+                auto exists = [&](size_t i) {
+                    size_t index;
+                    return infiles.getFileList()->locate(infiles.position(i), index)->isAvailable(index);
+                };
+                for (size_t i = 0; i < infiles.size(); i++) {
+                    if (exists(i)) incr_infile_size += infiles.getSize(i);
+                }
+
+                for (size_t i = 0; i < infiles.size(); i++) {
+                    if (!exists(i)) continue;
+
+                    // Distribute the files on all caches until desired hitrate is reached
+                    // TODO: Rework the initialization of input files on caches
+                    if (cached_files_size < static_cast<sg_size_t>(hitrate * static_cast<double>(incr_infile_size))) {
+                        auto const &f = infiles.getRegistered(i);
+                        for (const auto &cache: cache_storage_services) {
+                            if (SimpleSimulator::cache_granularity == CacheGranularity::BlockGranularity) {
+                                BlockCacheIndex::get(cache).addFile(f);
+                                continue;
+                            }
+                            // simulation->stageFile(f, cache);
+                            wrench::StorageService::createFileAtLocation(wrench::FileLocation::LOCATION(cache, f));
+                            SimpleSimulator::global_file_map[cache].touchFile(f.get());
+                        }
+                        cached_files_size += f->getSize();
+                    }
+                }
+                if (static_cast<double>(cached_files_size) / static_cast<double>(incr_infile_size) < hitrate) {
+                    throw std::runtime_error("Desired hitrate was not reached!");
+                }
+            }
+        }
+    } catch (std::runtime_error &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 0;
+    }
+    DCSIM_PROFILE_STOP(InputStaging);
+    std::cerr << "Duplicating workloads ... "
+              << "\n";
+    size_t num_total_jobs = 0;
+    DCSIM_PROFILE_START(JobDuplication);
+    for (auto const &wms: workload_execution_controllers) {
+        /* Duplicate the workload */
+        auto new_workload_spec = duplicateJobs(wms->get_workload_spec(), duplications);
+        wms->set_workload_spec(new_workload_spec);
+        num_total_jobs += new_workload_spec.size();
+    }
+    DCSIM_PROFILE_STOP(JobDuplication);
+    std::cerr << "The simulation now has " << std::to_string(num_total_jobs) << " jobs in total " << std::endl;
+
+
+    /* Start the progress heartbeat */
+    if (heartbeat_interval > 0.) {
+        try {
+            Heartbeat::init(workload_execution_controllers, heartbeat_interval, heartbeat_filename);
+        } catch (std::runtime_error &e) {
+            std::cerr << "Exception: " << e.what() << std::endl;
+            return 0;
+        }
+    }
+
+    /* Start the network monitor */
+    if (network_monitor_interval > 0.) {
+        // Without a host of type networkmonitor the monitor runs alongside the execution controllers
+        std::set<std::string> monitor_hosts = SimpleSimulator::network_monitors.empty() ? SimpleSimulator::executors : SimpleSimulator::network_monitors;
+        if (monitor_hosts.empty()) {
+            std::cerr << "WARNING: No host of type networkmonitor or executor configured, network monitoring is disabled!" << std::endl;
+        } else {
+            // A single monitor samples all links and disks of the platform, wherever it runs
+            if (monitor_hosts.size() > 1) {
+                std::cerr << "WARNING: More than one " << (SimpleSimulator::network_monitors.empty() ? "executor" : "networkmonitor")
+                          << " host configured, the network monitor runs on the first one only!" << std::endl;
+            }
+            auto const &host = *monitor_hosts.begin();
+            try {
+                NetworkMonitor::writeHeader(network_monitor_filename);
+            } catch (std::runtime_error &e) {
+                std::cerr << "Exception: " << e.what() << std::endl;
+                return 0;
+            }
+            std::cerr << "Starting network monitor on host " << host << ", writing to " << network_monitor_filename << std::endl;
+            simgrid::s4u::Actor::create("network_monitor", simgrid::s4u::Host::by_name(host),
+                                        NetworkMonitor(network_monitor_filename, network_monitor_interval))
+                    ->daemonize();
+        }
+    }
+
+
+    /* Launch the simulation */
+    try {
+        /* initialize output-dump file */
+        filedump.open(filename, ios::out | ios::trunc);
+        if (filedump.is_open()) {
+            filedump << "job.tag"
+                     << ", ";// << "job.ncpu" << ", " << "job.memory" << ", " << "job.disk" << ", ";
+            filedump << "machine.name"
+                     << ", ";
+            filedump << "hitrate"
+                     << ", ";
+            filedump << "job.start"
+                     << ", "
+                     << "job.end"
+                     << ", "
+                     << "job.computetime"
+                     << ", "
+                     << "job.flops"
+                     << ", ";
+            filedump << "infiles.transfertime"
+                     << ", "
+                     << "infiles.size"
+                     << ", "
+                     << "outfiles.transfertime"
+                     << ", "
+                     << "outfiles.size"
+                     << "\n";
+            filedump.close();
+            std::cerr << "Wrote header of the output dump into file " << filename << std::endl;
+        } else {
+            throw std::runtime_error("Couldn't open output-file " + filename + " for dump!");
+        }
+        std::cerr << "Launching the Simulation..." << std::endl;
+        DCSIM_PROFILE_START(SimulationLaunch);
+        simulation->launch();
+        DCSIM_PROFILE_STOP(SimulationLaunch);
+    } catch (std::runtime_error &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 0;
+    }
+    std::cerr << "Simulation done! " << wrench::Simulation::getCurrentSimulatedDate() << std::endl;
+
+    CacheMonitor::finalize(wrench::Simulation::getCurrentSimulatedDate());
+
+    if (Profiler::enabled) {
+        try {
+            Profiler::dump(profile_filename);
+            std::cerr << "Wrote profiling information into file " << profile_filename << std::endl;
+        } catch (std::runtime_error &e) {
+            std::cerr << "Exception: " << e.what() << std::endl;
+        }
+    }
+
+    // Check routes from workers to remote storages
+#if 0
+    for (auto worker_host_name: SimpleSimulator::worker_hosts) {
+        for(auto remote_host_name: SimpleSimulator::storage_hosts) {
+            std::vector<simgrid::s4u::Link*> links;
+            double latency;
+            auto worker_host = simgrid::s4u::Host::by_name(worker_host_name);
+            auto remote_host = simgrid::s4u::Host::by_name(remote_host_name);
+            worker_host->route_to(remote_host, links, &latency);
+            std::cerr << "ROUTE FROM " << worker_host->get_name() << " TO " << remote_host->get_name() << ":\n";
+            for (const auto l: links) {
+                std::cerr << " - " << l->get_name() << "\n";
+            }
+        }
+    }
+#endif
+
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include <wrench-dev.h>
+
+#include "CacheMonitor.h"
+#include "SimpleSimulator.h"
+#include "BlockCacheIndex.h"
+#include "util/DefaultValues.h"
+
+#include <fstream>
+
+
+bool CacheMonitor::enabled = false;
+std::map<std::shared_ptr<wrench::StorageService>, CacheMonitor::CacheCounters> CacheMonitor::counters;
+std::string CacheMonitor::filename;
+double CacheMonitor::window = 0.;
+double CacheMonitor::window_start = 0.;
+
+
+/**
+ * @brief Register the caches to monitor and write the header of the output-dump file
+ *
+ * @param cache_storage_services Cache storage services to keep counters for
+ * @param outputdump_name name of the file where the time series are written to
+ * @param window length of a time window in simulated seconds
+ *
+ * @throw std::runtime_error
+ */
+void CacheMonitor::init(const std::set<std::shared_ptr<wrench::StorageService>> &cache_storage_services,
+                        const std::string &outputdump_name, const double window) {
+    if (window <= 0.) {
+        throw std::runtime_error("The cache monitor time window has to be positive!");
+    }
+    for (auto const &cache: cache_storage_services) {
+        CacheMonitor::counters[cache] = CacheCounters();
+    }
+    CacheMonitor::filename = outputdump_name;
+    CacheMonitor::window = window;
+    CacheMonitor::window_start = 0.;
+
+    std::ofstream filedump(outputdump_name, ios::out | ios::trunc);
+    if (!filedump.is_open()) {
+        throw std::runtime_error("Couldn't open output-file " + outputdump_name + " for cache monitor dump!");
+    }
+    filedump << "window.start"
+             << ", "
+             << "window.end"
+             << ", "
+             << "cache.host"
+             << ", "
+             << "cache.tier"
+             << ", "
+             << "bytes.hit"
+             << ", "
+             << "bytes.missed"
+             << ", "
+             << "hitrate"
+             << ", "
+             << "bytes.admitted"
+             << ", "
+             << "evictions"
+             << ", "
+             << "bytes.evicted"
+             << ", "
+             << "occupancy"
+             << "\n";
+    filedump.close();
+    CacheMonitor::enabled = true;
+}
+
+/**
+ * @brief Account data that was found in a cache
+ *
+ * @param cache Cache storage service serving the data
+ * @param num_bytes Number of bytes found
+ */
+void CacheMonitor::recordHit(const std::shared_ptr<wrench::StorageService> &cache, const sg_size_t num_bytes) {
+    if (!CacheMonitor::enabled) return;
+    CacheMonitor::advance(wrench::Simulation::getCurrentSimulatedDate());
+    CacheMonitor::counters[cache].bytes_hit += num_bytes;
+}
+
+/**
+ * @brief Account data that was not found in a cache, which was designated to cache it
+ *
+ * @param cache Cache storage service designated to hold the data
+ * @param num_bytes Number of bytes missed
+ */
+void CacheMonitor::recordMiss(const std::shared_ptr<wrench::StorageService> &cache, const sg_size_t num_bytes) {
+    if (!CacheMonitor::enabled) return;
+    CacheMonitor::advance(wrench::Simulation::getCurrentSimulatedDate());
+    CacheMonitor::counters[cache].bytes_missed += num_bytes;
+}
+
+/**
+ * @brief Account data admitted into a cache, which is written there
+ *
+ * @param cache Cache storage service the data is written to
+ * @param num_bytes Number of bytes admitted
+ */
+void CacheMonitor::recordAdmission(const std::shared_ptr<wrench::StorageService> &cache, const sg_size_t num_bytes) {
+    if (!CacheMonitor::enabled) return;
+    CacheMonitor::advance(wrench::Simulation::getCurrentSimulatedDate());
+    CacheMonitor::counters[cache].bytes_admitted += num_bytes;
+}
+
+/**
+ * @brief Account a file evicted from a cache
+ *
+ * @param cache Cache storage service the file was evicted from
+ * @param num_bytes Size of the evicted file
+ */
+void CacheMonitor::recordEviction(const std::shared_ptr<wrench::StorageService> &cache, const sg_size_t num_bytes) {
+    if (!CacheMonitor::enabled) return;
+    CacheMonitor::advance(wrench::Simulation::getCurrentSimulatedDate());
+    CacheMonitor::counters[cache].evictions++;
+    CacheMonitor::counters[cache].bytes_evicted += num_bytes;
+}
+
+/**
+ * @brief Flush all windows which have been completed until the given time
+ *
+ * @param now Current simulated time
+ */
+void CacheMonitor::advance(const double now) {
+    while (now >= CacheMonitor::window_start + CacheMonitor::window) {
+        CacheMonitor::flushWindow(CacheMonitor::window_start + CacheMonitor::window);
+    }
+}
+
+/**
+ * @brief Flush the remaining windows including the last, partially filled one
+ *
+ * @param end_time Simulated time at which the simulation ended
+ */
+void CacheMonitor::finalize(const double end_time) {
+    if (!CacheMonitor::enabled) return;
+    CacheMonitor::advance(end_time);
+    if (end_time > CacheMonitor::window_start) {
+        CacheMonitor::flushWindow(end_time);
+    }
+    CacheMonitor::enabled = false;
+}
+
+/**
+ * @brief Append one row per cache for the current window to the output-dump file
+ * and reset the counters for the next window
+ *
+ * @param window_end End of the current window
+ *
+ * @throw std::runtime_error
+ */
+void CacheMonitor::flushWindow(const double window_end) {
+    std::ofstream filedump(CacheMonitor::filename, ios::out | ios::app);
+    if (!filedump.is_open()) {
+        throw std::runtime_error("Couldn't open output-file " + CacheMonitor::filename + " for cache monitor dump!");
+    }
+    for (auto &cache_counters: CacheMonitor::counters) {
+        auto const &c = cache_counters.second;
+        double hitrate = DefaultValues::UndefinedDouble;
+        if (c.bytes_hit + c.bytes_missed > 0) {
+            hitrate = static_cast<double>(c.bytes_hit) / static_cast<double>(c.bytes_hit + c.bytes_missed);
+        }
+        filedump << std::to_string(CacheMonitor::window_start) << ", " << std::to_string(window_end) << ", ";
+        filedump << cache_counters.first->getHostname() << ", ";
+        filedump << SimpleSimulator::cache_tiers[cache_counters.first->getHostname()] << ", ";
+        filedump << std::to_string(c.bytes_hit) << ", " << std::to_string(c.bytes_missed) << ", " << hitrate << ", ";
+        filedump << std::to_string(c.bytes_admitted) << ", ";
+        filedump << std::to_string(c.evictions) << ", " << std::to_string(c.bytes_evicted) << ", ";
+        filedump << std::to_string(BlockCacheIndex::getOccupiedSpace(cache_counters.first)) << "\n";
+        cache_counters.second = CacheCounters();
+    }
+    filedump.close();
+    CacheMonitor::window_start = window_end;
+}
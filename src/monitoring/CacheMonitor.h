@@ -0,0 +1,53 @@
+
+
+#ifndef S_CACHEMONITOR_H
+#define S_CACHEMONITOR_H
+
+#include <wrench-dev.h>
+
+/**
+ * @brief Collection of per-cache counters, which are flushed
+ * as time-windowed series into a CSV file.
+ * Windows are aligned to multiples of the window length in simulated time.
+ */
+class CacheMonitor {
+
+public:
+    static void init(const std::set<std::shared_ptr<wrench::StorageService>> &cache_storage_services,
+                     const std::string &outputdump_name, double window);
+
+    static void recordHit(const std::shared_ptr<wrench::StorageService> &cache, sg_size_t num_bytes);
+    static void recordMiss(const std::shared_ptr<wrench::StorageService> &cache, sg_size_t num_bytes);
+    static void recordAdmission(const std::shared_ptr<wrench::StorageService> &cache, sg_size_t num_bytes);
+    static void recordEviction(const std::shared_ptr<wrench::StorageService> &cache, sg_size_t num_bytes);
+
+    static void finalize(double end_time);
+
+    /** @brief Whether cache counters are collected */
+    static bool enabled;
+
+private:
+    /**
+     * @brief Counters accumulated within the current time window
+     */
+    struct CacheCounters {
+        sg_size_t bytes_hit = 0;
+        sg_size_t bytes_missed = 0;
+        sg_size_t bytes_admitted = 0;
+        size_t evictions = 0;
+        sg_size_t bytes_evicted = 0;
+    };
+
+    static void advance(double now);
+    static void flushWindow(double window_end);
+
+    static std::map<std::shared_ptr<wrench::StorageService>, CacheCounters> counters;
+    /** @brief Filename for the output-dump file */
+    static std::string filename;
+    /** @brief Length of a time window in simulated seconds */
+    static double window;
+    /** @brief Start of the current time window */
+    static double window_start;
+};
+
+#endif//S_CACHEMONITOR_H
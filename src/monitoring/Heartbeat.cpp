@@ -0,0 +1,177 @@
+#include <wrench-dev.h>
+
+#include "Heartbeat.h"
+#include "Profiler.h"
+#include "WorkloadExecutionController.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+
+std::vector<std::shared_ptr<WorkloadExecutionController>> Heartbeat::execution_controllers;
+double Heartbeat::interval = 0.;
+std::string Heartbeat::filename;
+std::chrono::steady_clock::time_point Heartbeat::last_beat;
+double Heartbeat::last_simulated_time = 0.;
+unsigned long long Heartbeat::last_schedule_calls = 0;
+std::atomic<long long> Heartbeat::last_beat_ns{0};
+std::atomic<double> Heartbeat::simulated_time{0.};
+std::thread Heartbeat::watchdog;
+std::mutex Heartbeat::mutex;
+std::condition_variable Heartbeat::stopped;
+bool Heartbeat::running = false;
+
+
+/**
+ * @brief Register the heartbeat to be called whenever the simulated time advances,
+ * start its watchdog and write a last report when the simulation ends
+ *
+ * @param execution_controllers Execution controllers whose progress is reported
+ * @param interval Wall-clock seconds between two reports
+ * @param outputdump_name Sidecar file the reports are appended to, empty for stderr
+ *
+ * @throw std::runtime_error
+ */
+void Heartbeat::init(const std::vector<std::shared_ptr<WorkloadExecutionController>> &execution_controllers,
+                     const double interval, const std::string &outputdump_name) {
+    Heartbeat::execution_controllers = execution_controllers;
+    Heartbeat::interval = interval;
+    Heartbeat::filename = outputdump_name;
+    if (!outputdump_name.empty()) {
+        std::ofstream filedump(outputdump_name, ios::out | ios::trunc);
+        if (!filedump.is_open()) {
+            throw std::runtime_error("Couldn't open output-file " + outputdump_name + " for heartbeat!");
+        }
+        filedump.close();
+    }
+    Heartbeat::last_beat = std::chrono::steady_clock::now();
+    Heartbeat::last_beat_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Heartbeat::last_beat.time_since_epoch()).count();
+    simgrid::s4u::Engine::on_time_advance_cb([](double /* delta */) {
+        Heartbeat::beat(wrench::Simulation::getCurrentSimulatedDate(), false);
+    });
+    simgrid::s4u::Engine::on_simulation_end_cb([]() {
+        Heartbeat::stop();
+        Heartbeat::beat(simgrid::s4u::Engine::get_clock(), true);
+    });
+    Heartbeat::running = true;
+    Heartbeat::watchdog = std::thread(Heartbeat::watch);
+    // Also stop the watchdog when the simulator exits without ending the simulation
+    std::atexit([]() { Heartbeat::stop(); });
+}
+
+/**
+ * @brief Write a progress report from the scheduler loop when the wall-clock interval has elapsed,
+ * which also covers simulation steps that don't advance the simulated time
+ */
+void Heartbeat::poll() {
+    if (Heartbeat::interval <= 0.) return;
+    Heartbeat::beat(wrench::Simulation::getCurrentSimulatedDate(), false);
+}
+
+/**
+ * @brief Write a progress report when the wall-clock interval has elapsed
+ *
+ * @param now Current simulated time
+ * @param force Whether to report regardless of the interval
+ */
+void Heartbeat::beat(const double now, const bool force) {
+    Heartbeat::simulated_time = now;
+    auto wall_now = std::chrono::steady_clock::now();
+    double wall_elapsed = std::chrono::duration<double>(wall_now - Heartbeat::last_beat).count();
+    if (!force && wall_elapsed < Heartbeat::interval) return;
+    wall_elapsed = std::max(wall_elapsed, 1e-9);
+
+    unsigned long long schedule_calls = Profiler::counters[ProfilingCounter::ScheduleCalls];
+
+    std::stringstream report;
+    report << "[heartbeat] simulated time: " << now << " s"
+           << ", speed: " << (now - Heartbeat::last_simulated_time) / wall_elapsed << " sim-s/s"
+           << ", scheduler passes: " << static_cast<double>(schedule_calls - Heartbeat::last_schedule_calls) / wall_elapsed << " /s"
+           << ", RSS: " << Heartbeat::currentRSS() / 1024 << " MiB";
+    for (auto const &wms: Heartbeat::execution_controllers) {
+        report << "\n\t" << wms->getWorkloadName()
+               << ": " << wms->getNumCompletedJobs() << " completed"
+               << ", " << wms->getNumJobsInFlight() << " in flight"
+               << ", " << wms->getNumJobsQueued() << " queued";
+    }
+    report << "\n";
+    Heartbeat::write(report.str());
+
+    Heartbeat::last_beat = wall_now;
+    Heartbeat::last_beat_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wall_now.time_since_epoch()).count();
+    Heartbeat::last_simulated_time = now;
+    Heartbeat::last_schedule_calls = schedule_calls;
+}
+
+/**
+ * @brief Main loop of the watchdog thread, reporting a stall whenever the simulation hasn't reported for two intervals.
+ * It only reads the state published atomically by the simulation, as the simulation keeps running meanwhile.
+ */
+void Heartbeat::watch() {
+    auto period = std::chrono::duration<double>(Heartbeat::interval);
+    std::unique_lock<std::mutex> lock(Heartbeat::mutex);
+    while (!Heartbeat::stopped.wait_for(lock, period, [] { return !Heartbeat::running; })) {
+        auto wall_now = std::chrono::steady_clock::now();
+        double silent = std::chrono::duration<double>(wall_now.time_since_epoch()).count() -
+                        static_cast<double>(Heartbeat::last_beat_ns.load()) * 1e-9;
+        // The simulation reports shortly after each interval, so only twice its silence is a stall
+        if (silent < 2 * Heartbeat::interval) continue;
+        std::stringstream report;
+        report << "[heartbeat] stalled for " << silent << " s at simulated time " << Heartbeat::simulated_time.load() << " s"
+               << ", RSS: " << Heartbeat::currentRSS() / 1024 << " MiB\n";
+        lock.unlock();
+        Heartbeat::write(report.str());
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Stop the watchdog thread
+ */
+void Heartbeat::stop() {
+    {
+        std::lock_guard<std::mutex> lock(Heartbeat::mutex);
+        Heartbeat::running = false;
+    }
+    Heartbeat::stopped.notify_all();
+    if (Heartbeat::watchdog.joinable()) {
+        Heartbeat::watchdog.join();
+    }
+}
+
+/**
+ * @brief Write a report to stderr or the sidecar file, from the simulation or the watchdog
+ *
+ * @param report Report to write
+ */
+void Heartbeat::write(const std::string &report) {
+    static std::mutex write_mutex;
+    std::lock_guard<std::mutex> lock(write_mutex);
+    if (Heartbeat::filename.empty()) {
+        std::cerr << report;
+    } else {
+        std::ofstream filedump(Heartbeat::filename, ios::out | ios::app);
+        if (filedump.is_open()) {
+            filedump << report;
+            filedump.close();
+        }
+    }
+}
+
+/**
+ * @brief Current resident set size of the simulator process
+ *
+ * @return the RSS in kB, or -1 if it cannot be determined
+ */
+long Heartbeat::currentRSS() {
+    std::ifstream statm("/proc/self/statm");
+    long pages_total = 0;
+    long pages_resident = 0;
+    if (!(statm >> pages_total >> pages_resident)) {
+        return -1;
+    }
+    return pages_resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
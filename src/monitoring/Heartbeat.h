@@ -0,0 +1,57 @@
+#ifndef S_HEARTBEAT_H
+#define S_HEARTBEAT_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class WorkloadExecutionController;
+
+/**
+ * @brief Periodic progress report of a running simulation.
+ * Every given number of wall-clock seconds it reports the simulated time, the job progress per workload,
+ * the simulation speed, scheduler passes per second and the current RSS. Reports are written
+ * when the simulated time advances and from the scheduler loop, which also runs while the simulated time stands still.
+ * A watchdog thread reports a stall when neither has happened for two intervals, and a last report is written at the end.
+ */
+class Heartbeat {
+
+public:
+    static void init(const std::vector<std::shared_ptr<WorkloadExecutionController>> &execution_controllers,
+                     double interval, const std::string &outputdump_name);
+
+    static void poll();
+
+private:
+    static void beat(double now, bool force);
+    static void watch();
+    static void stop();
+    static void write(const std::string &report);
+    static long currentRSS();
+
+    static std::vector<std::shared_ptr<WorkloadExecutionController>> execution_controllers;
+    /** @brief Wall-clock seconds between two reports, 0 if the heartbeat is off */
+    static double interval;
+    /** @brief Filename for the reports, empty for stderr */
+    static std::string filename;
+
+    static std::chrono::steady_clock::time_point last_beat;
+    static double last_simulated_time;
+    static unsigned long long last_schedule_calls;
+
+    /** @brief Wall-clock time of the last report in nanoseconds and the simulated time then, read by the watchdog */
+    static std::atomic<long long> last_beat_ns;
+    static std::atomic<double> simulated_time;
+
+    static std::thread watchdog;
+    static std::mutex mutex;
+    static std::condition_variable stopped;
+    static bool running;
+};
+
+#endif//S_HEARTBEAT_H
@@ -0,0 +1,213 @@
+#include <wrench-dev.h>
+#include <simgrid/plugins/load.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(network_monitor, "Log category for NetworkMonitor");
+
+#include "NetworkMonitor.h"
+#include "computation/AsyncRead.h"
+
+#include <cmath>
+#include <fstream>
+
+
+bool NetworkMonitor::enabled = false;
+double NetworkMonitor::start_time = 0.;
+double NetworkMonitor::sampling_interval = 0.;
+double NetworkMonitor::last_sample_time = 0.;
+std::map<std::string, std::vector<std::pair<double, double>>> NetworkMonitor::disk_traffic;
+
+
+/**
+ * @brief Construct a new NetworkMonitor::NetworkMonitor object
+ * to be used as the body of a daemonized monitoring actor.
+ *
+ * @param outputdump_name name of the file where the sampled time series are appended to
+ * @param interval simulated time in seconds between two samples
+ */
+NetworkMonitor::NetworkMonitor(const std::string &outputdump_name, const double interval) {
+    this->filename = outputdump_name;
+    this->interval = interval;
+}
+
+/**
+ * @brief Write the header of the monitoring output-dump file
+ *
+ * @param outputdump_name name of the file to (over)write
+ *
+ * @throw std::runtime_error
+ */
+void NetworkMonitor::writeHeader(const std::string &outputdump_name) {
+    std::ofstream filedump(outputdump_name, ios::out | ios::trunc);
+    if (!filedump.is_open()) {
+        throw std::runtime_error("Couldn't open output-file " + outputdump_name + " for network monitor dump!");
+    }
+    filedump << "time"
+             << ", "
+             << "resource.type"
+             << ", "
+             << "resource.name"
+             << ", "
+             << "load"
+             << ", "
+             << "utilization"
+             << "\n";
+    filedump.close();
+}
+
+/**
+ * @brief Account bytes read from the disk of a storage service by a completed transfer
+ *
+ * @param storage_service Storage service the data was read from
+ * @param num_bytes Number of bytes read
+ * @param start_date Simulated time the transfer started, it ends now
+ */
+void NetworkMonitor::recordRead(const std::shared_ptr<wrench::StorageService> &storage_service, const sg_size_t num_bytes, const double start_date) {
+    if (!NetworkMonitor::enabled) return;
+    NetworkMonitor::recordTraffic(storage_service->getHostname(), static_cast<double>(num_bytes), start_date, true);
+}
+
+/**
+ * @brief Account bytes written to the disk of a storage service by a completed transfer
+ *
+ * @param storage_service Storage service the data was written to
+ * @param num_bytes Number of bytes written
+ * @param start_date Simulated time the transfer started, it ends now
+ */
+void NetworkMonitor::recordWrite(const std::shared_ptr<wrench::StorageService> &storage_service, const sg_size_t num_bytes, const double start_date) {
+    if (!NetworkMonitor::enabled) return;
+    NetworkMonitor::recordTraffic(storage_service->getHostname(), static_cast<double>(num_bytes), start_date, false);
+}
+
+/**
+ * @brief Spread the bytes of a transfer ending now evenly over the sampling intervals it spans,
+ * so that long transfers don't show up as a single spike exceeding the disk's bandwidth.
+ * Bytes transferred before the monitor started are dropped.
+ *
+ * @param hostname Storage host whose disk was read or written
+ * @param num_bytes Number of bytes transferred
+ * @param start_date Simulated time the transfer started
+ * @param read Whether the bytes were read, or written otherwise
+ */
+void NetworkMonitor::recordTraffic(const std::string &hostname, const double num_bytes, const double start_date, const bool read) {
+    double end_date = wrench::Simulation::getCurrentSimulatedDate();
+    double duration = end_date - start_date;
+    // Like the samples, intervals include the date they end at
+    auto interval_of = [](double date) {
+        return static_cast<size_t>(std::max(std::ceil((date - NetworkMonitor::start_time) / NetworkMonitor::sampling_interval) - 1., 0.));
+    };
+    size_t last = interval_of(end_date);
+    auto &traffic = NetworkMonitor::disk_traffic[hostname];
+    if (traffic.size() <= last) {
+        traffic.resize(last + 1, std::make_pair(0., 0.));
+    }
+    if (duration <= 0.) {
+        (read ? traffic[last].first : traffic[last].second) += num_bytes;
+        return;
+    }
+    for (size_t i = interval_of(start_date); i <= last; i++) {
+        double begin = std::max(start_date, NetworkMonitor::start_time + static_cast<double>(i) * NetworkMonitor::sampling_interval);
+        double end = std::min(end_date, NetworkMonitor::start_time + static_cast<double>(i + 1) * NetworkMonitor::sampling_interval);
+        if (end <= begin) continue;
+        (read ? traffic[i].first : traffic[i].second) += num_bytes * (end - begin) / duration;
+    }
+}
+
+/**
+ * @brief Main loop of the monitoring actor.
+ * Links are tracked with SimGrid's link load plugin, which has to be
+ * initialized before the platform is instantiated.
+ * Disk load is derived from the data volume the computations read from
+ * and write to the storage services, and dumped once the simulation ends.
+ */
+void NetworkMonitor::operator()() {
+    WRENCH_INFO("Starting network monitor sampling every %.2lf s", this->interval);
+    for (auto const &link: simgrid::s4u::Engine::get_instance()->get_all_links()) {
+        if (link->get_name() == "__loopback__") continue;
+        sg_link_load_track(link);
+    }
+    NetworkMonitor::start_time = wrench::Simulation::getCurrentSimulatedDate();
+    NetworkMonitor::sampling_interval = this->interval;
+    NetworkMonitor::enabled = true;
+
+    // The actor is a daemon killed with the last controller, so the last partial interval is sampled at the end
+    NetworkMonitor::last_sample_time = NetworkMonitor::start_time;
+    NetworkMonitor final_monitor = *this;
+    simgrid::s4u::Engine::on_simulation_end_cb([final_monitor]() {
+        double now = simgrid::s4u::Engine::get_clock();
+        if (now > NetworkMonitor::last_sample_time) {
+            final_monitor.sample(now, now - NetworkMonitor::last_sample_time);
+        }
+        final_monitor.dumpDiskTraffic(now);
+    });
+    while (true) {
+        simgrid::s4u::this_actor::sleep_for(this->interval);
+        double now = wrench::Simulation::getCurrentSimulatedDate();
+        this->sample(now, now - NetworkMonitor::last_sample_time);
+        NetworkMonitor::last_sample_time = now;
+    }
+}
+
+/**
+ * @brief Append the average load of all links since the last sample
+ * to the output-dump file. Idle resources are omitted to keep the dump compact.
+ *
+ * @param now Simulated time of the sample
+ * @param elapsed Simulated time since the last sample
+ *
+ * @throw std::runtime_error
+ */
+void NetworkMonitor::sample(const double now, const double elapsed) const {
+    std::ofstream filedump(this->filename, ios::out | ios::app);
+    if (!filedump.is_open()) {
+        throw std::runtime_error("Couldn't open output-file " + this->filename + " for network monitor dump!");
+    }
+
+    for (auto const &link: simgrid::s4u::Engine::get_instance()->get_all_links()) {
+        if (link->get_name() == "__loopback__") continue;
+        double load = sg_link_get_avg_load(link);
+        sg_link_load_reset(link);
+        if (load <= 0.) continue;
+        filedump << std::to_string(now) << ", link, " << link->get_name() << ", "
+                 << std::to_string(load) << ", " << std::to_string(load / link->get_bandwidth()) << "\n";
+    }
+
+    filedump.close();
+}
+
+/**
+ * @brief Append the average I/O load of all disks in each sampling interval to the output-dump file,
+ * time-stamped with the end of the interval like the link samples. Idle intervals are omitted.
+ *
+ * @param end Simulated time the simulation ended, closing the last interval
+ *
+ * @throw std::runtime_error
+ */
+void NetworkMonitor::dumpDiskTraffic(const double end) const {
+    std::ofstream filedump(this->filename, ios::out | ios::app);
+    if (!filedump.is_open()) {
+        throw std::runtime_error("Couldn't open output-file " + this->filename + " for network monitor dump!");
+    }
+
+    for (auto const &traffic: NetworkMonitor::disk_traffic) {
+        auto disk = AsyncRead::getStorageDisk(traffic.first);
+        if (!disk) continue;
+        for (size_t i = 0; i < traffic.second.size(); i++) {
+            double begin = NetworkMonitor::start_time + static_cast<double>(i) * this->interval;
+            double now = std::min(begin + this->interval, end);
+            double elapsed = now - begin;
+            if (elapsed <= 0.) continue;
+            double read_load = traffic.second[i].first / elapsed;
+            double write_load = traffic.second[i].second / elapsed;
+            if (read_load > 0.) {
+                filedump << std::to_string(now) << ", disk_read, " << traffic.first << ":" << disk->get_name() << ", "
+                         << std::to_string(read_load) << ", " << std::to_string(read_load / disk->get_read_bandwidth()) << "\n";
+            }
+            if (write_load > 0.) {
+                filedump << std::to_string(now) << ", disk_write, " << traffic.first << ":" << disk->get_name() << ", "
+                         << std::to_string(write_load) << ", " << std::to_string(write_load / disk->get_write_bandwidth()) << "\n";
+            }
+        }
+    }
+
+    filedump.close();
+}
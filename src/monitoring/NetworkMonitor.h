@@ -0,0 +1,53 @@
+
+
+#ifndef S_NETWORKMONITOR_H
+#define S_NETWORKMONITOR_H
+
+#include <wrench-dev.h>
+
+/**
+ * @brief Body of the actor running on hosts of type "networkmonitor".
+ * Periodically samples the load of all links and appends it as a time series to a CSV file.
+ * The I/O load of all storage disks is accounted per interval as well, spreading the bytes of every
+ * transfer evenly over the intervals it spans. As transfers are only accounted once they complete,
+ * the disk load is appended when the simulation ends.
+ * The interval still open when the simulation ends is sampled as well.
+ */
+class NetworkMonitor {
+
+public:
+    NetworkMonitor(const std::string &outputdump_name, double interval);
+
+    void operator()();
+
+    static void recordRead(const std::shared_ptr<wrench::StorageService> &storage_service, sg_size_t num_bytes, double start_date);
+    static void recordWrite(const std::shared_ptr<wrench::StorageService> &storage_service, sg_size_t num_bytes, double start_date);
+
+    static void writeHeader(const std::string &outputdump_name);
+
+    /** @brief Whether a monitor is running and I/O traffic has to be recorded */
+    static bool enabled;
+
+private:
+    /** @brief Filename for the output-dump file */
+    std::string filename;
+    /** @brief Simulated time between two samples */
+    double interval;
+
+    void sample(double now, double elapsed) const;
+    void dumpDiskTraffic(double end) const;
+
+    static void recordTraffic(const std::string &hostname, double num_bytes, double start_date, bool read);
+
+    /** @brief Simulated time the monitor started sampling */
+    static double start_time;
+    /** @brief Simulated time between two samples, shared with the static accounting of the disk traffic */
+    static double sampling_interval;
+    /** @brief Simulated time of the last sample */
+    static double last_sample_time;
+
+    /** @brief Bytes read from and written to the disk of a storage host in each sampling interval */
+    static std::map<std::string, std::vector<std::pair<double, double>>> disk_traffic;
+};
+
+#endif//S_NETWORKMONITOR_H
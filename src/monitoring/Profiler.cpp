@@ -0,0 +1,48 @@
+#include "Profiler.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <sys/resource.h>
+
+#include <nlohmann/json.hpp>
+
+
+#define F(name) #name,
+const char *profiling_phase_names[] = {PROFILING_PHASES(F) nullptr};
+const char *profiling_counter_names[] = {PROFILING_COUNTERS(F) nullptr};
+#undef F
+
+bool Profiler::enabled = false;
+std::array<unsigned long long, NumProfilingCounters> Profiler::counters{};
+std::array<std::chrono::steady_clock::time_point, NumProfilingPhases> Profiler::phase_start{};
+std::array<std::chrono::steady_clock::duration, NumProfilingPhases> Profiler::phase_duration{};
+
+
+/**
+ * @brief Write the collected phase timings (in seconds), counter values
+ * and the peak resident set size (in kB) as JSON into a file
+ *
+ * @param outputdump_name name of the file to write to
+ *
+ * @throw std::runtime_error
+ */
+void Profiler::dump(const std::string &outputdump_name) {
+    nlohmann::json profile;
+    for (int p = 0; p < NumProfilingPhases; p++) {
+        profile["phases"][profiling_phase_names[p]] = std::chrono::duration<double>(Profiler::phase_duration[p]).count();
+    }
+    for (int c = 0; c < NumProfilingCounters; c++) {
+        profile["counters"][profiling_counter_names[c]] = Profiler::counters[c];
+    }
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        profile["max_rss_kb"] = usage.ru_maxrss;
+    }
+
+    std::ofstream profiledump(outputdump_name, std::ios::out | std::ios::trunc);
+    if (!profiledump.is_open()) {
+        throw std::runtime_error("Couldn't open output-file " + outputdump_name + " for profiling dump!");
+    }
+    profiledump << profile.dump(4) << std::endl;
+    profiledump.close();
+}
@@ -0,0 +1,83 @@
+
+
+#ifndef S_PROFILER_H
+#define S_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <string>
+
+
+#define PROFILING_PHASES(F)     \
+    F(ScenarioLoading)          \
+    F(DatasetConstruction)      \
+    F(WorkloadSampling)         \
+    F(FileAssignment)           \
+    F(PlatformInstantiation)    \
+    F(InputStaging)             \
+    F(JobDuplication)           \
+    F(SimulationLaunch)
+
+#define PROFILING_COUNTERS(F)   \
+    F(ScheduleCalls)            \
+    F(JobsScanned)              \
+    F(CacheLookups)             \
+    F(CacheEvictions)           \
+    F(StreamedBlocks)
+
+#define F(name) name,
+enum ProfilingPhase { PROFILING_PHASES(F) NumProfilingPhases };
+enum ProfilingCounter { PROFILING_COUNTERS(F) NumProfilingCounters };
+#undef F
+
+
+/**
+ * @brief Lightweight self-profiling of the simulator:
+ * wall-clock timers for the setup phases and counters for hot code paths.
+ * When compiled without DCSIM_PROFILING all instrumentation macros vanish,
+ * otherwise a disabled profiler costs a single predictable branch.
+ */
+class Profiler {
+
+public:
+    static void startPhase(ProfilingPhase phase) {
+        Profiler::phase_start[phase] = std::chrono::steady_clock::now();
+    }
+
+    static void stopPhase(ProfilingPhase phase) {
+        Profiler::phase_duration[phase] += std::chrono::steady_clock::now() - Profiler::phase_start[phase];
+    }
+
+    static void dump(const std::string &outputdump_name);
+
+    /** @brief Whether the profiling information is collected */
+    static bool enabled;
+    /** @brief Values of the hot path counters */
+    static std::array<unsigned long long, NumProfilingCounters> counters;
+
+private:
+    static std::array<std::chrono::steady_clock::time_point, NumProfilingPhases> phase_start;
+    static std::array<std::chrono::steady_clock::duration, NumProfilingPhases> phase_duration;
+};
+
+
+#ifdef DCSIM_PROFILING
+#define DCSIM_PROFILE_COUNT(counter, n)                                   \
+    do {                                                                  \
+        if (Profiler::enabled) Profiler::counters[ProfilingCounter::counter] += (n); \
+    } while (0)
+#define DCSIM_PROFILE_START(phase)                                        \
+    do {                                                                  \
+        if (Profiler::enabled) Profiler::startPhase(ProfilingPhase::phase); \
+    } while (0)
+#define DCSIM_PROFILE_STOP(phase)                                         \
+    do {                                                                  \
+        if (Profiler::enabled) Profiler::stopPhase(ProfilingPhase::phase); \
+    } while (0)
+#else
+#define DCSIM_PROFILE_COUNT(counter, n) do { } while (0)
+#define DCSIM_PROFILE_START(phase) do { } while (0)
+#define DCSIM_PROFILE_STOP(phase) do { } while (0)
+#endif
+
+#endif//S_PROFILER_H
@@ -0,0 +1,55 @@
+#include "AliasTable.h"
+
+#include <numeric>
+#include <stdexcept>
+
+
+/**
+ * @brief Build the alias table with Vose's method
+ *
+ * @param weights Non-negative weights of the indices, not all zero
+ *
+ * @throw std::runtime_error
+ */
+AliasTable::AliasTable(const std::vector<double> &weights) {
+    double total = std::accumulate(weights.begin(), weights.end(), 0.);
+    if (weights.empty() || !(total > 0.)) {
+        throw std::runtime_error("An alias table requires at least one positive weight!");
+    }
+    size_t n = weights.size();
+    this->probabilities.resize(n);
+    this->aliases.resize(n);
+
+    // Scale the weights to an average of 1 and split them into under- and overfull indices
+    std::vector<double> scaled(n);
+    std::vector<size_t> small, large;
+    for (size_t i = 0; i < n; i++) {
+        if (weights[i] < 0.) {
+            throw std::runtime_error("An alias table requires non-negative weights!");
+        }
+        scaled[i] = weights[i] * static_cast<double>(n) / total;
+        (scaled[i] < 1. ? small : large).push_back(i);
+    }
+    // Fill each underfull index up with the excess of an overfull one
+    while (!small.empty() && !large.empty()) {
+        size_t s = small.back();
+        small.pop_back();
+        size_t l = large.back();
+        this->probabilities[s] = scaled[s];
+        this->aliases[s] = l;
+        scaled[l] -= 1. - scaled[s];
+        if (scaled[l] < 1.) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Remaining indices are full up to rounding errors
+    for (auto i: large) {
+        this->probabilities[i] = 1.;
+        this->aliases[i] = i;
+    }
+    for (auto i: small) {
+        this->probabilities[i] = 1.;
+        this->aliases[i] = i;
+    }
+}
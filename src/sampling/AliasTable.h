@@ -0,0 +1,56 @@
+
+
+#ifndef S_ALIASTABLE_H
+#define S_ALIASTABLE_H
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Draw a uniformly distributed real number from [0, 1) with full double precision
+ *
+ * @param generator Uniform random bit generator
+ * @return double
+ */
+template<class URBG>
+inline double uniformReal(URBG &generator) {
+    double u = std::generate_canonical<double, std::numeric_limits<double>::digits>(generator);
+    // some standard libraries may round up to 1
+    return u < 1. ? u : std::nextafter(1., 0.);
+}
+
+/**
+ * @brief Walker alias table, which draws an index with probability proportional
+ * to its weight in constant time from a single uniform number
+ */
+class AliasTable {
+
+public:
+    AliasTable() = default;
+    explicit AliasTable(const std::vector<double> &weights);
+
+    /**
+     * @brief Draw an index
+     *
+     * @param generator Uniform random bit generator
+     * @return size_t
+     */
+    template<class URBG>
+    size_t operator()(URBG &generator) const {
+        double u = uniformReal(generator) * static_cast<double>(this->probabilities.size());
+        auto index = static_cast<size_t>(u);
+        return (u - static_cast<double>(index) < this->probabilities[index]) ? index : this->aliases[index];
+    }
+
+    /** @brief Number of indices */
+    size_t size() const { return this->probabilities.size(); }
+
+private:
+    // probability to keep an index instead of taking its alias
+    std::vector<double> probabilities;
+    std::vector<size_t> aliases;
+};
+
+#endif//S_ALIASTABLE_H
@@ -0,0 +1,167 @@
+#include "InfileAssignment.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "Philox.h"
+#include "Sampler.h"
+
+
+/**
+ * @brief Create a file assignment from its JSON description, e.g.
+ * {"type": "window", "overlap": 2, "passes": 1}. Without a description files are assigned contiguously.
+ *
+ * @param config JSON object containing the type and parameters of the assignment
+ * @param infiles_per_job Number of files per job, 0 to derive it from the numbers of files and jobs
+ *
+ * @throw std::runtime_error
+ */
+InfileAssignment::InfileAssignment(const nlohmann::json &config, const size_t infiles_per_job) {
+    this->infiles_per_job = infiles_per_job;
+    if (config.is_null() || config.empty()) {
+        return;
+    }
+    std::string type = config.value("type", "contiguous");
+    if (type == "contiguous") {
+        this->type = InfileAssignmentType::ContiguousAssignment;
+    } else if (type == "window") {
+        this->type = InfileAssignmentType::WindowAssignment;
+        this->overlap = config.value("overlap", static_cast<size_t>(0));
+        if (this->infiles_per_job > 0 && this->overlap >= this->infiles_per_job) {
+            throw std::runtime_error("Window file assignment needs an overlap smaller than infiles_per_job!");
+        }
+    } else if (type == "zipf") {
+        this->type = InfileAssignmentType::ZipfAssignment;
+        this->exponent = config.value("exponent", 1.);
+        if (this->exponent < 0.) {
+            throw std::runtime_error("Zipf file assignment needs a non-negative exponent!");
+        }
+    } else if (type == "popularity") {
+        this->type = InfileAssignmentType::PopularityAssignment;
+        if (!config.contains("popularity")) {
+            throw std::runtime_error("Popularity file assignment needs a popularity distribution!");
+        }
+        this->popularity = config["popularity"];
+    } else {
+        throw std::runtime_error("File assignment " + type + " invalid. Please choose 'contiguous', 'window', 'zipf', or 'popularity'");
+    }
+    this->passes = config.value("passes", static_cast<size_t>(1));
+    if (this->passes == 0) {
+        throw std::runtime_error("File assignment needs at least one pass over the files!");
+    }
+}
+
+/**
+ * @brief Prepare assigning files to the jobs of a workload, drawing file popularities and building the alias table
+ *
+ * @param num_files Number of files of the workload's input datasets
+ * @param num_jobs Number of jobs
+ * @param seed Seed of the random streams
+ * @param stream Name of the random streams, which the job index and file index further identify
+ *
+ * @throw std::runtime_error
+ */
+void InfileAssignment::prepare(const size_t num_files, const size_t num_jobs, const unsigned int seed, const std::string &stream) {
+    this->num_files = num_files;
+    this->seed = seed;
+    this->stream = stream;
+    if (num_jobs == 0 || num_files == 0) {
+        this->num_infiles = 0;
+        return;
+    }
+
+    switch (this->type) {
+        case InfileAssignmentType::ContiguousAssignment:
+        case InfileAssignmentType::WindowAssignment:
+            // Jobs advance by the stride through the passes over the files and overlap with the following jobs
+            if (this->infiles_per_job > 0) {
+                this->num_infiles = this->infiles_per_job;
+                this->stride = this->infiles_per_job - std::min(this->overlap, this->infiles_per_job - 1);
+            } else {
+                this->stride = num_files * this->passes / num_jobs;
+                this->num_infiles = this->stride > 0 ? this->stride + this->overlap : 0;
+            }
+            // A job reads each file at most once
+            this->num_infiles = std::min(this->num_infiles, num_files);
+            return;
+        case InfileAssignmentType::ZipfAssignment:
+        case InfileAssignmentType::PopularityAssignment: {
+            this->num_infiles = this->infiles_per_job > 0 ? this->infiles_per_job : num_files * this->passes / num_jobs;
+            this->num_infiles = std::min(this->num_infiles, num_files);
+            std::vector<double> weights(num_files);
+            if (this->type == InfileAssignmentType::ZipfAssignment) {
+                for (size_t f = 0; f < num_files; f++) {
+                    weights[f] = std::pow(static_cast<double>(f + 1), -this->exponent);
+                }
+            } else {
+                Sampler popularity_dist(this->popularity, false, 0.);
+                for (size_t f = 0; f < num_files; f++) {
+                    PhiloxEngine popularity_stream(seed, stream + "/popularity", f, 0);
+                    weights[f] = popularity_dist(popularity_stream);
+                }
+            }
+            this->file_table = AliasTable(weights);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Assign files to a job. Weighted assignments draw distinct files for each job,
+ * with a bounded number of redraws, so that a job may get fewer files when the popularity is very concentrated.
+ *
+ * @param job_id Index of the job in the workload
+ * @param assign_file Function called with the index of each file assigned to the job
+ */
+void InfileAssignment::assignJob(const size_t job_id, const std::function<void(size_t)> &assign_file) const {
+    if (this->num_infiles == 0) {
+        return;
+    }
+    switch (this->type) {
+        case InfileAssignmentType::ContiguousAssignment:
+        case InfileAssignmentType::WindowAssignment: {
+            size_t offset, count;
+            this->getRange(job_id, offset, count);
+            for (size_t i = 0; i < count; i++) {
+                assign_file((offset + i) % this->num_files);
+            }
+            return;
+        }
+        case InfileAssignmentType::ZipfAssignment:
+        case InfileAssignmentType::PopularityAssignment: {
+            PhiloxEngine job_stream(this->seed, this->stream, job_id, 0);
+            std::unordered_set<size_t> drawn;
+            size_t max_draws = 32 * this->num_infiles;
+            for (size_t draws = 0; drawn.size() < this->num_infiles && draws < max_draws; draws++) {
+                size_t f = this->file_table(job_stream);
+                if (drawn.insert(f).second) {
+                    assign_file(f);
+                }
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Range of files assigned to a job by a contiguous or window assignment, which wraps around the end of the files
+ *
+ * @param job_id Index of the job in the workload
+ * @param offset Index of the first file
+ * @param count Number of files, fewer than configured once the passes over the files are used up
+ */
+void InfileAssignment::getRange(const size_t job_id, size_t &offset, size_t &count) const {
+    offset = 0;
+    count = 0;
+    if (this->num_infiles == 0 || !this->isContiguous()) {
+        return;
+    }
+    size_t begin = job_id * this->stride;
+    size_t end = std::min(begin + this->num_infiles, this->num_files * this->passes);
+    if (begin >= end) {
+        return;
+    }
+    offset = begin % this->num_files;
+    count = end - begin;
+}
@@ -0,0 +1,75 @@
+
+
+#ifndef S_INFILEASSIGNMENT_H
+#define S_INFILEASSIGNMENT_H
+
+#include <functional>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "AliasTable.h"
+
+/**
+ * @brief Ways of assigning the files of a workload's input datasets to its jobs
+ */
+enum InfileAssignmentType {
+    // consecutive, disjoint chunks of files, optionally in several passes over the files
+    ContiguousAssignment,
+    // consecutive chunks of files, of which consecutive jobs share some
+    WindowAssignment,
+    // files drawn with probabilities decreasing as a power of their rank
+    ZipfAssignment,
+    // files drawn with probabilities proportional to their sampled popularity
+    PopularityAssignment
+};
+
+/**
+ * @brief Strategy assigning input-files to the jobs of a workload.
+ * Weighted strategies draw files from an alias table, so that assigning
+ * takes constant time per assigned file, and every job draws from its own random stream,
+ * so that jobs can be assigned their files concurrently once the assignment is prepared.
+ */
+class InfileAssignment {
+
+public:
+    InfileAssignment() = default;
+    InfileAssignment(const nlohmann::json &config, size_t infiles_per_job);
+
+    void prepare(size_t num_files, size_t num_jobs, unsigned int seed, const std::string &stream);
+
+    void assignJob(size_t job_id, const std::function<void(size_t)> &assign_file) const;
+
+    void getRange(size_t job_id, size_t &offset, size_t &count) const;
+
+    /** @brief Whether jobs are assigned contiguous ranges of files, wrapping around the end of the files */
+    bool isContiguous() const {
+        return this->type == InfileAssignmentType::ContiguousAssignment || this->type == InfileAssignmentType::WindowAssignment;
+    }
+
+    /** @brief Number of files assigned to each job */
+    size_t getInfilesPerJob() const { return this->num_infiles; }
+
+private:
+    InfileAssignmentType type = InfileAssignmentType::ContiguousAssignment;
+    // number of files per job as configured, 0 to derive it from the numbers of files and jobs
+    size_t infiles_per_job = 0;
+    // number of passes over the files with contiguous and window assignment
+    size_t passes = 1;
+    // number of files consecutive jobs share with window assignment
+    size_t overlap = 0;
+    // exponent of Zipf's law
+    double exponent = 1.;
+    // distribution of the file popularities
+    nlohmann::json popularity;
+
+    // state of a prepared assignment
+    size_t num_files = 0;
+    size_t num_infiles = 0;
+    size_t stride = 0;
+    unsigned int seed = 0;
+    std::string stream;
+    AliasTable file_table;
+};
+
+#endif//S_INFILEASSIGNMENT_H
@@ -0,0 +1,47 @@
+
+
+#ifndef S_PARALLELFOR_H
+#define S_PARALLELFOR_H
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Run a function over the index range [0, n) split into contiguous chunks on several threads
+ *
+ * @param n Number of indices
+ * @param num_threads Number of threads, 0 for all hardware threads
+ * @param body Function called with the begin and end of a chunk, must be safe to run concurrently
+ *
+ * @throw the first exception thrown by the body
+ */
+inline void parallelFor(const size_t n, unsigned int num_threads, const std::function<void(size_t, size_t)> &body) {
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    // not worth a thread for few indices
+    num_threads = static_cast<unsigned int>(std::min<size_t>(num_threads, std::max<size_t>(n / 1024, 1)));
+    if (num_threads == 1) {
+        body(0, n);
+        return;
+    }
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(num_threads);
+    size_t chunk = (n + num_threads - 1) / num_threads;
+    for (unsigned int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            try {
+                body(std::min(n, t * chunk), std::min(n, (t + 1) * chunk));
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    for (auto const &error: errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+#endif//S_PARALLELFOR_H
@@ -0,0 +1,95 @@
+
+
+#ifndef S_PHILOX_H
+#define S_PHILOX_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+/**
+ * @brief Counter-based Philox4x32-10 random bit generator (Salmon et al., SC'11).
+ * Every stream is identified by a seed, a name, an index and a field, so that e.g. each attribute
+ * of each job gets its own stream, whose draws don't depend on the order the streams are used in.
+ */
+class PhiloxEngine {
+
+public:
+    using result_type = uint32_t;
+
+    /**
+     * @brief Construct the generator of a stream
+     *
+     * @param seed Seed of the simulation
+     * @param name Name of the stream family, e.g. a workload
+     * @param index Index within the family, e.g. a job
+     * @param field Field of the indexed item, e.g. a job attribute
+     */
+    PhiloxEngine(const uint64_t seed, const std::string &name, const uint64_t index, const uint32_t field) {
+        uint64_t key = PhiloxEngine::mix(seed ^ PhiloxEngine::mix(PhiloxEngine::hash(name)));
+        this->key = {static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)};
+        this->counter = {0, field, static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32)};
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Draw the next 32 random bits of the stream
+     *
+     * @return result_type
+     */
+    result_type operator()() {
+        if (this->position == this->block.size()) {
+            this->block = PhiloxEngine::bijection(this->counter, this->key);
+            this->counter[0]++;
+            this->position = 0;
+        }
+        return this->block[this->position++];
+    }
+
+private:
+    /**
+     * @brief Ten Philox rounds, mapping a counter to four random words
+     */
+    static std::array<uint32_t, 4> bijection(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> k) {
+        for (int round = 0; round < 10; round++) {
+            uint64_t p0 = static_cast<uint64_t>(0xD2511F53) * ctr[0];
+            uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57) * ctr[2];
+            ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ k[0], static_cast<uint32_t>(p1),
+                   static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ k[1], static_cast<uint32_t>(p0)};
+            k[0] += 0x9E3779B9;
+            k[1] += 0xBB67AE85;
+        }
+        return ctr;
+    }
+
+    /**
+     * @brief SplitMix64 finalizer
+     */
+    static uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief FNV-1a hash of a stream family name
+     */
+    static uint64_t hash(const std::string &name) {
+        uint64_t h = 0xCBF29CE484222325ULL;
+        for (unsigned char c: name) {
+            h ^= c;
+            h *= 0x100000001B3ULL;
+        }
+        return h;
+    }
+
+    std::array<uint32_t, 2> key;
+    std::array<uint32_t, 4> counter;
+    std::array<uint32_t, 4> block{};
+    size_t position = 4;
+};
+
+#endif//S_PHILOX_H
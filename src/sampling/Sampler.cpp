@@ -0,0 +1,202 @@
+#include <wrench-dev.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(sampler, "Log category for Sampler");
+
+#include "Sampler.h"
+
+#include <algorithm>
+
+
+/**
+ * @brief CDF of the standard normal distribution
+ *
+ * @param x
+ * @return double
+ */
+double normalCDF(const double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.));
+}
+
+/**
+ * @brief Quantile function of the standard normal distribution, using Acklam's rational
+ * approximation refined by a Halley step to full double precision
+ *
+ * @param p Probability
+ * @return double
+ */
+double normalQuantile(const double p) {
+    if (p <= 0.) return -std::numeric_limits<double>::infinity();
+    if (p >= 1.) return std::numeric_limits<double>::infinity();
+
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double p_low = 0.02425;
+
+    double x;
+    if (p < p_low) {
+        double q = std::sqrt(-2. * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.);
+    } else if (p <= 1. - p_low) {
+        double q = p - 0.5;
+        double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.);
+    } else {
+        double q = std::sqrt(-2. * std::log1p(-p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.);
+    }
+    double e = normalCDF(x) - p;
+    double u = e * std::sqrt(2. * M_PI) * std::exp(x * x / 2.);
+    return x - u / (1. + x * u / 2.);
+}
+
+/**
+ * @brief Value at which the interpolated CDF reaches a probability
+ *
+ * @param p Probability
+ * @return double
+ */
+double EmpiricalDistribution::quantile(const double p) const {
+    auto i = static_cast<size_t>(std::lower_bound(this->cdf.begin(), this->cdf.end(), p) - this->cdf.begin());
+    if (i == 0) return this->values.front();
+    if (i == this->cdf.size()) return this->values.back();
+    return this->values[i - 1] + (this->values[i] - this->values[i - 1]) * (p - this->cdf[i - 1]) / (this->cdf[i] - this->cdf[i - 1]);
+}
+
+/**
+ * @brief Probability of a value less than the given one according to the interpolated CDF
+ *
+ * @param x
+ * @return double
+ */
+double EmpiricalDistribution::probability(const double x) const {
+    auto i = static_cast<size_t>(std::lower_bound(this->values.begin(), this->values.end(), x) - this->values.begin());
+    if (i == 0) return 0.;
+    if (i == this->values.size()) return 1.;
+    return this->cdf[i - 1] + (this->cdf[i] - this->cdf[i - 1]) * (x - this->values[i - 1]) / (this->values[i] - this->values[i - 1]);
+}
+
+/**
+ * @brief Construct a sampler from its JSON description. Real valued samplers support the types
+ * histogram (bins, counts), gaussian (average, sigma), lognormal (mu, sigma of the logarithm),
+ * exponential (lambda) and empirical (values, cdf); integer valued ones the types
+ * histogram (counts of the values from 0 on) and poisson (mu).
+ *
+ * @param json Description of the distribution
+ * @param integral Whether the sampler draws integers
+ * @param lower_bound Smallest value drawn, the distribution is truncated below it
+ *
+ * @throw std::runtime_error
+ */
+Sampler::Sampler(const nlohmann::json &json, const bool integral, const double lower_bound) {
+    auto type = json["type"].get<std::string>();
+    if (type == "histogram" && integral) {
+        if (json.contains("bins")) {
+            WRENCH_WARN("Ignoring configured bins for integer distribution!");
+        }
+        auto weights = json["counts"].get<std::vector<double>>();
+        for (size_t value = 0; value < weights.size() && static_cast<double>(value) < lower_bound; value++) {
+            weights[value] = 0.;
+        }
+        if (std::all_of(weights.begin(), weights.end(), [](double w) { return w <= 0.; })) {
+            throw std::runtime_error("Histogram has no counts left above the lower bound " + std::to_string(lower_bound) + "!");
+        }
+        this->distribution = DiscreteDistribution{0., AliasTable(weights)};
+    } else if (type == "histogram") {
+        auto bins = json["bins"].get<std::vector<double>>();
+        auto counts = json["counts"].get<std::vector<double>>();
+        if (bins.size() != counts.size() + 1) {
+            throw std::runtime_error("Histogram needs one bin edge more than counts!");
+        }
+        HistogramDistribution histogram;
+        std::vector<double> weights;
+        for (size_t b = 0; b < counts.size(); b++) {
+            double low = bins[b];
+            double high = bins[b + 1];
+            if (high <= lower_bound) continue;
+            double weight = counts[b];
+            if (low < lower_bound) {
+                weight *= (high - lower_bound) / (high - low);
+                low = lower_bound;
+            }
+            histogram.lower_edges.push_back(low);
+            histogram.widths.push_back(high - low);
+            weights.push_back(weight);
+        }
+        if (std::all_of(weights.begin(), weights.end(), [](double w) { return w <= 0.; })) {
+            throw std::runtime_error("Histogram has no counts left above the lower bound " + std::to_string(lower_bound) + "!");
+        }
+        histogram.bins = AliasTable(weights);
+        this->distribution = std::move(histogram);
+    } else if (type == "poisson" && integral) {
+        auto mu = json["mu"].get<double>();
+        if (mu <= 0.) {
+            throw std::runtime_error("Poisson distribution needs a positive mu!");
+        }
+        // Tabulate the probabilities from the lower bound up to far in the tail
+        double first = std::max(0., std::ceil(lower_bound));
+        double last = std::max(first, mu + 12. * std::sqrt(mu) + 20.);
+        std::vector<double> weights;
+        for (double k = first; k <= last; k++) {
+            weights.push_back(std::exp(k * std::log(mu) - mu - std::lgamma(k + 1.)));
+        }
+        if (std::all_of(weights.begin(), weights.end(), [](double w) { return w <= 0.; })) {
+            throw std::runtime_error("Poisson distribution has no probability left above the lower bound " + std::to_string(lower_bound) + "!");
+        }
+        this->distribution = DiscreteDistribution{first, AliasTable(weights)};
+    } else if (type == "gaussian" && !integral) {
+        auto average = json["average"].get<double>();
+        auto sigma = json["sigma"].get<double>();
+        double lower_cdf = 0.;
+        if (sigma > 0. && std::isfinite(lower_bound)) {
+            lower_cdf = normalCDF((lower_bound - average) / sigma);
+        } else if (sigma <= 0. && average < lower_bound) {
+            lower_cdf = 1.;
+        }
+        if (lower_cdf >= 1.) {
+            throw std::runtime_error("Gaussian distribution has no probability left above the lower bound " + std::to_string(lower_bound) + "!");
+        }
+        this->distribution = GaussianDistribution{average, sigma, lower_cdf};
+    } else if (type == "lognormal" && !integral) {
+        auto mu = json["mu"].get<double>();
+        auto sigma = json["sigma"].get<double>();
+        if (sigma <= 0.) {
+            throw std::runtime_error("Lognormal distribution needs a positive sigma!");
+        }
+        double lower_cdf = (lower_bound > 0.) ? normalCDF((std::log(lower_bound) - mu) / sigma) : 0.;
+        if (lower_cdf >= 1.) {
+            throw std::runtime_error("Lognormal distribution has no probability left above the lower bound " + std::to_string(lower_bound) + "!");
+        }
+        this->distribution = LognormalDistribution{mu, sigma, lower_cdf};
+    } else if (type == "exponential" && !integral) {
+        auto lambda = json["lambda"].get<double>();
+        if (lambda <= 0.) {
+            throw std::runtime_error("Exponential distribution needs a positive lambda!");
+        }
+        this->distribution = ExponentialDistribution{lambda, std::max(0., lower_bound)};
+    } else if (type == "empirical" && !integral) {
+        EmpiricalDistribution empirical{json["values"].get<std::vector<double>>(), json["cdf"].get<std::vector<double>>(), 0.};
+        if (empirical.values.empty() || empirical.values.size() != empirical.cdf.size() ||
+            !std::is_sorted(empirical.values.begin(), empirical.values.end()) ||
+            !std::is_sorted(empirical.cdf.begin(), empirical.cdf.end()) ||
+            empirical.cdf.front() < 0. || empirical.cdf.back() != 1.) {
+            throw std::runtime_error("Empirical distribution needs ascending values with their ascending cumulative probabilities up to 1!");
+        }
+        empirical.lower_cdf = empirical.probability(lower_bound);
+        if (empirical.lower_cdf >= 1.) {
+            throw std::runtime_error("Empirical distribution has no probability left above the lower bound " + std::to_string(lower_bound) + "!");
+        }
+        this->distribution = std::move(empirical);
+    } else {
+        throw std::runtime_error("Random number generation for type " + type + " not implemented for " +
+                                 (integral ? "integer" : "real") + " valued distributions!");
+    }
+}
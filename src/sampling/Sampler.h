@@ -0,0 +1,141 @@
+
+
+#ifndef S_SAMPLER_H
+#define S_SAMPLER_H
+
+#include <cmath>
+#include <limits>
+#include <variant>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "AliasTable.h"
+
+double normalCDF(double x);
+double normalQuantile(double p);
+
+/**
+ * @brief Gaussian distribution truncated from below, drawn by inverting the CDF
+ */
+struct GaussianDistribution {
+    double average;
+    double sigma;
+    // CDF value of the lower bound of the standard normal distribution
+    double lower_cdf;
+
+    template<class URBG>
+    double operator()(URBG &generator) const {
+        double u = this->lower_cdf + (1. - this->lower_cdf) * uniformReal(generator);
+        if (this->sigma <= 0.) return this->average;
+        return this->average + this->sigma * normalQuantile(u);
+    }
+};
+
+/**
+ * @brief Lognormal distribution truncated from below, drawn by inverting the CDF
+ */
+struct LognormalDistribution {
+    // average and standard deviation of the logarithm
+    double mu;
+    double sigma;
+    // CDF value of the lower bound of the logarithm's standard normal distribution
+    double lower_cdf;
+
+    template<class URBG>
+    double operator()(URBG &generator) const {
+        double u = this->lower_cdf + (1. - this->lower_cdf) * uniformReal(generator);
+        return std::exp(this->mu + this->sigma * normalQuantile(u));
+    }
+};
+
+/**
+ * @brief Exponential distribution shifted to its lower bound, which is equivalent to truncating it
+ */
+struct ExponentialDistribution {
+    double lambda;
+    double lower_bound;
+
+    template<class URBG>
+    double operator()(URBG &generator) const {
+        return this->lower_bound - std::log1p(-uniformReal(generator)) / this->lambda;
+    }
+};
+
+/**
+ * @brief Piecewise constant distribution over histogram bins, drawing the bin from an alias table
+ * and a uniform value within it. Bins below the lower bound are cut off.
+ */
+struct HistogramDistribution {
+    // lower edges and widths of the bins
+    std::vector<double> lower_edges;
+    std::vector<double> widths;
+    AliasTable bins;
+
+    template<class URBG>
+    double operator()(URBG &generator) const {
+        size_t bin = this->bins(generator);
+        return this->lower_edges[bin] + this->widths[bin] * uniformReal(generator);
+    }
+};
+
+/**
+ * @brief Distribution over the integers from an offset on, drawn from an alias table
+ */
+struct DiscreteDistribution {
+    double offset;
+    AliasTable values;
+
+    template<class URBG>
+    double operator()(URBG &generator) const {
+        return this->offset + static_cast<double>(this->values(generator));
+    }
+};
+
+/**
+ * @brief Empirical distribution given by points of its CDF, drawn by inverting the linearly interpolated CDF
+ */
+struct EmpiricalDistribution {
+    std::vector<double> values;
+    // cumulative probabilities of the values, the last one is 1
+    std::vector<double> cdf;
+    // CDF value of the lower bound
+    double lower_cdf;
+
+    template<class URBG>
+    double operator()(URBG &generator) const {
+        return this->quantile(this->lower_cdf + (1. - this->lower_cdf) * uniformReal(generator));
+    }
+
+    double quantile(double p) const;
+    double probability(double x) const;
+};
+
+/**
+ * @brief Sampler of a distribution described in JSON, truncated to values of at least a lower bound.
+ * Tables are precomputed on construction so that a draw takes constant time and no rejection is needed.
+ */
+class Sampler {
+
+public:
+    Sampler() = default;
+    Sampler(const nlohmann::json &json, bool integral, double lower_bound);
+
+    /**
+     * @brief Draw a value
+     *
+     * @param generator Uniform random bit generator
+     * @return double
+     */
+    template<class URBG>
+    double operator()(URBG &generator) const {
+        return std::visit([&generator](auto const &distribution) { return distribution(generator); }, this->distribution);
+    }
+
+private:
+    std::variant<HistogramDistribution, DiscreteDistribution, GaussianDistribution, LognormalDistribution,
+                 ExponentialDistribution, EmpiricalDistribution>
+            distribution;
+};
+
+#endif//S_SAMPLER_H
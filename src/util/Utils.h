@@ -38,4 +38,260 @@ inline StorageServiceBufferType get_ssbuffer_type(const std::string &ssprop) {
 }
 
 
+/**
+ * @enum StreamingMode
+ * @brief Engines modelling the XRootD-ish block streaming of input-files
+ */
+enum StreamingMode {
+    BlockStreaming, /* one read and one compute activity per block */
+    FluidStreaming  /* one coalesced read and one coalesced compute activity per file, pipelining modelled analytically */
+};
+
+/**
+ * @brief Get the StreamingMode from its name
+ *
+ * @param mode
+ * @return StreamingMode
+ */
+inline StreamingMode get_streaming_mode(const std::string &mode) {
+    if (mode == "block") {
+        return StreamingMode::BlockStreaming;
+    } else if (mode == "fluid") {
+        return StreamingMode::FluidStreaming;
+    } else {
+        throw std::runtime_error("Streaming mode " + mode + " invalid. Please choose 'block' or 'fluid'");
+    }
+}
+
+
+/**
+ * @enum CacheFillMode
+ * @brief Ways files missed in a cache become available there
+ */
+enum CacheFillMode {
+    InstantFill, /* the file is created in the cache at once on the miss */
+    InFlightFill /* the file is written into the cache block by block while the first job reads it */
+};
+
+/**
+ * @brief Get the CacheFillMode from its name
+ *
+ * @param mode
+ * @return CacheFillMode
+ */
+inline CacheFillMode get_cache_fill_mode(const std::string &mode) {
+    if (mode == "instant") {
+        return CacheFillMode::InstantFill;
+    } else if (mode == "inflight") {
+        return CacheFillMode::InFlightFill;
+    } else {
+        throw std::runtime_error("Cache fill mode " + mode + " invalid. Please choose 'instant' or 'inflight'");
+    }
+}
+
+
+/**
+ * @enum CacheGranularity
+ * @brief Units in which caches hold input-files
+ */
+enum CacheGranularity {
+    FileGranularity, /* files are cached and looked up as a whole */
+    BlockGranularity /* files are cached and looked up in blocks of the XRootD block size */
+};
+
+/**
+ * @brief Get the CacheGranularity from its name
+ *
+ * @param granularity
+ * @return CacheGranularity
+ */
+inline CacheGranularity get_cache_granularity(const std::string &granularity) {
+    if (granularity == "file") {
+        return CacheGranularity::FileGranularity;
+    } else if (granularity == "block") {
+        return CacheGranularity::BlockGranularity;
+    } else {
+        throw std::runtime_error("Cache granularity " + granularity + " invalid. Please choose 'file' or 'block'");
+    }
+}
+
+
+/**
+ * @enum CacheAdmissionPolicy
+ * @brief Policies deciding whether a missed file is written into a cache
+ */
+enum CacheAdmissionPolicy {
+    AdmitAlways,         /* every missed file is cached */
+    AdmitOnSecondAccess, /* a file is cached when it is missed again while remembered in the ghost list */
+    AdmitBySize,         /* files within a size range are cached */
+    AdmitByName,         /* files of listed datasets or read by jobs of listed workloads are cached */
+    AdmitByProbability   /* files are cached with a fixed probability */
+};
+
+/**
+ * @brief Get the CacheAdmissionPolicy from its name
+ *
+ * @param policy
+ * @return CacheAdmissionPolicy
+ */
+inline CacheAdmissionPolicy get_cache_admission_policy(const std::string &policy) {
+    if (policy == "always") {
+        return CacheAdmissionPolicy::AdmitAlways;
+    } else if (policy == "second-access") {
+        return CacheAdmissionPolicy::AdmitOnSecondAccess;
+    } else if (policy == "size") {
+        return CacheAdmissionPolicy::AdmitBySize;
+    } else if (policy == "name") {
+        return CacheAdmissionPolicy::AdmitByName;
+    } else if (policy == "probability") {
+        return CacheAdmissionPolicy::AdmitByProbability;
+    } else {
+        throw std::runtime_error("Cache admission policy " + policy + " invalid. Please choose 'always', 'second-access', 'size', 'name' or 'probability'");
+    }
+}
+
+
+/**
+ * @enum CachePlacementStrategy
+ * @brief Strategies choosing the cache a missed file is written to
+ */
+enum CachePlacementStrategy {
+    RandomPlacement,     /* any reachable cache drawn with the simulator's seeded generator */
+    HashPlacement,       /* stable home per file by hashing its ID over the reachable caches */
+    FreeSpacePlacement,  /* reachable cache with the most free space */
+    LeastLoadedPlacement /* reachable cache with the fewest jobs reading from or filling it */
+};
+
+/**
+ * @brief Get the CachePlacementStrategy from its name
+ *
+ * @param strategy
+ * @return CachePlacementStrategy
+ */
+inline CachePlacementStrategy get_cache_placement_strategy(const std::string &strategy) {
+    if (strategy == "random") {
+        return CachePlacementStrategy::RandomPlacement;
+    } else if (strategy == "hash") {
+        return CachePlacementStrategy::HashPlacement;
+    } else if (strategy == "freespace") {
+        return CachePlacementStrategy::FreeSpacePlacement;
+    } else if (strategy == "leastloaded") {
+        return CachePlacementStrategy::LeastLoadedPlacement;
+    } else {
+        throw std::runtime_error("Cache placement strategy " + strategy + " invalid. Please choose 'random', 'hash', 'freespace' or 'leastloaded'");
+    }
+}
+
+
+/**
+ * @enum ReplicaSelectionPolicy
+ * @brief Policies choosing the GRID storage service a file is read from
+ */
+enum ReplicaSelectionPolicy {
+    FirstReplica,      /* first storage service holding the file */
+    BandwidthReplica,  /* shortest transfer time estimated from route bandwidth and latency */
+    ThroughputReplica, /* highest exponentially decaying average of the observed throughput */
+    RoundRobinReplica, /* cycle through the storage services holding the file */
+    WeightedReplica    /* random, weighted by the serving capacity of the storage services */
+};
+
+/**
+ * @brief Get the ReplicaSelectionPolicy from its name
+ *
+ * @param policy
+ * @return ReplicaSelectionPolicy
+ */
+inline ReplicaSelectionPolicy get_replica_selection_policy(const std::string &policy) {
+    if (policy == "first") {
+        return ReplicaSelectionPolicy::FirstReplica;
+    } else if (policy == "bandwidth") {
+        return ReplicaSelectionPolicy::BandwidthReplica;
+    } else if (policy == "throughput") {
+        return ReplicaSelectionPolicy::ThroughputReplica;
+    } else if (policy == "roundrobin") {
+        return ReplicaSelectionPolicy::RoundRobinReplica;
+    } else if (policy == "weighted") {
+        return ReplicaSelectionPolicy::WeightedReplica;
+    } else {
+        throw std::runtime_error("Replica selection policy " + policy + " invalid. Please choose 'first', 'bandwidth', 'throughput', 'roundrobin' or 'weighted'");
+    }
+}
+
+
+/**
+ * @enum StageOutMode
+ * @brief Ways jobs write their output-files to the GRID
+ */
+enum StageOutMode {
+    DirectWrite,  /* the job writes its output-file to the GRID storage and keeps its slot until the write has finished */
+    LocalStageOut /* the job writes its output-file to a reachable cache, from which the site's upload agent pushes it to the GRID */
+};
+
+/**
+ * @brief Get the StageOutMode from its name
+ *
+ * @param mode
+ * @return StageOutMode
+ */
+inline StageOutMode get_stage_out_mode(const std::string &mode) {
+    if (mode == "direct") {
+        return StageOutMode::DirectWrite;
+    } else if (mode == "local") {
+        return StageOutMode::LocalStageOut;
+    } else {
+        throw std::runtime_error("Stage-out mode " + mode + " invalid. Please choose 'direct' or 'local'");
+    }
+}
+
+
+/**
+ * @enum EvictionPolicy
+ * @brief Policies choosing the file evicted from a cache when space is needed
+ */
+enum EvictionPolicy {
+    LRUEviction,         /* least recently used file */
+    FIFOEviction,        /* file cached first */
+    LFUEviction,         /* least frequently used file, ties broken by recency */
+    LargestFirstEviction /* largest file */
+};
+
+/**
+ * @brief Get the EvictionPolicy from its name
+ *
+ * @param policy
+ * @return EvictionPolicy
+ */
+inline EvictionPolicy get_eviction_policy(const std::string &policy) {
+    if (policy == "lru") {
+        return EvictionPolicy::LRUEviction;
+    } else if (policy == "fifo") {
+        return EvictionPolicy::FIFOEviction;
+    } else if (policy == "lfu") {
+        return EvictionPolicy::LFUEviction;
+    } else if (policy == "largest") {
+        return EvictionPolicy::LargestFirstEviction;
+    } else {
+        throw std::runtime_error("Eviction policy " + policy + " invalid. Please choose 'lru', 'fifo', 'lfu' or 'largest'");
+    }
+}
+
+
+/**
+ * @brief Derive the path of an additional output file from the main output-file path
+ * by appending a suffix to its stem, e.g. "out.csv" -> "out_suffix.csv"
+ *
+ * @param filename Path of the main output-file
+ * @param suffix Suffix to append
+ * @return std::string
+ */
+inline std::string derive_output_path(const std::string &filename, const std::string &suffix) {
+    auto dot = filename.find_last_of('.');
+    auto slash = filename.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return filename + "_" + suffix;
+    }
+    return filename.substr(0, dot) + "_" + suffix + filename.substr(dot);
+}
+
+
 #endif//S_UTILS_H